@@ -1,11 +1,13 @@
 #include <iostream>
+#include <string>
 #include <vector>
-#include <queue>
+#include <limits>
 #include <numeric>
-#include <functional>
+#include <algorithm>
 
-using AdjMatrix = std::vector<std::vector<int>>;
-using PriorityQueue = std::priority_queue<int, std::vector<int>, std::function<bool(int, int)>>;
+#include "../Common/CsrGraph.h"
+#include "../Common/BinaryGraphFormat.h"
+#include "../Common/Dijkstra.h"
 
 std::vector<int> constructPathFromPrevIndices(std::vector<int>& prevs, int dest) {
     std::vector<int> path;
@@ -21,40 +23,13 @@ std::vector<int> constructPathFromPrevIndices(std::vector<int>& prevs, int dest)
     return path;
 }
 
-std::vector<int> findShortestPathUsingDijkstra(AdjMatrix& graph, int startNode, int destNode) {
+std::vector<int> findShortestPathUsingDijkstra(const CsrGraph& graph, int startNode, int destNode) {
     // helper containers
-    std::vector<int> distances(graph.size(), std::numeric_limits<int>::max());
-    std::vector<bool> visited(graph.size(), false);
-    std::vector<int> prevs(graph.size(), -1);
+    std::vector<int> distances;
+    std::vector<int> prevs;
 
-    distances[startNode] = 0;
-
-    PriorityQueue prQueue([&distances](int node1, int node2) { 
-        return distances[node1] > distances[node2]; 
-    });
-
-    prQueue.push(startNode);
-
-    while (!prQueue.empty()) {
-        int minParentNode = prQueue.top();
-        prQueue.pop();
-
-        visited[minParentNode] = true;
-        
-        auto children = graph[minParentNode];
-        for (int child = 0; child < children.size(); child++) {
-            if (children[child] != 0 && !visited[child]) {
-                prQueue.push(child);
-
-                int newDistance = distances[minParentNode] + graph[minParentNode][child];
-
-                if (newDistance < distances[child]) {
-                    distances[child] = newDistance;
-                    prevs[child] = minParentNode;
-                }
-            }
-        }
-    }
+    // the search stops once the destination is settled, its path is final by then
+    runDijkstra(graph, startNode, distances, prevs, destNode);
 
     std::vector<int> shortestPathInReverse = constructPathFromPrevIndices(prevs, destNode);
 
@@ -70,25 +45,29 @@ void print(std::vector<int>& path) {
     std::cout << std::endl;
 }
 
-int main() {
-    AdjMatrix graph = {
-        // 0   1   2   3   4   5   6   7   8   9  10  11
-        { 0,  0,  0,  0,  0,  0, 10,  0, 12,  0,  0,  0 }, // 0
-        { 0,  0,  0,  0, 20,  0,  0, 26,  0,  5,  0,  6 }, // 1
-        { 0,  0,  0,  0,  0,  0,  0, 15, 14,  0,  0,  9 }, // 2
-        { 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  7,  0 }, // 3
-        { 0, 20,  0,  0,  0,  5, 17,  0,  0,  0,  0, 11 }, // 4
-        { 0,  0,  0,  0,  5,  0,  6,  0,  3,  0,  0, 33 }, // 5
-        {10,  0,  0,  0, 17,  6,  0,  0,  0,  0,  0,  0 }, // 6
-        { 0, 26, 15,  0,  0,  0,  0,  0,  0,  3,  0, 20 }, // 7
-        {12,  0, 14,  0,  0,  3,  0,  0,  0,  0,  0,  0 }, // 8
-        { 0,  5,  0,  0,  0,  0,  0,  3,  0,  0,  0,  0 }, // 9
-        { 0,  0,  0,  7,  0,  0,  0,  0,  0,  0,  0,  0 }, // 10
-        { 0,  6,  9,  0, 11, 33,  0, 20,  0,  0,  0,  0 }, // 11
+int main(int argc, char* argv[]) {
+    // undirected weighted graph with 12 nodes
+    std::vector<CsrEdge> edges = {
+        { 0,  6, 10 }, { 0,  8, 12 },
+        { 1,  4, 20 }, { 1,  7, 26 }, { 1,  9,  5 }, { 1, 11,  6 },
+        { 2,  7, 15 }, { 2,  8, 14 }, { 2, 11,  9 },
+        { 3, 10,  7 },
+        { 4,  5,  5 }, { 4,  6, 17 }, { 4, 11, 11 },
+        { 5,  6,  6 }, { 5,  8,  3 }, { 5, 11, 33 },
+        { 7,  9,  3 }, { 7, 11, 20 },
     };
 
+    CsrGraph graph(12, edges, true);
+
     int startNode = 0, destNode = 9;
 
+    // or a binary (.csrg) / text graph file with start and destination node from the command line
+    if (argc > 3) {
+        graph = loadGraph(argv[1]);
+        startNode = std::stoi(argv[2]);
+        destNode = std::stoi(argv[3]);
+    }
+
     std::vector<int> path = findShortestPathUsingDijkstra(graph, startNode, destNode);
 
     print(path);
@@ -1,11 +1,16 @@
 #include <iostream>
 #include <string>
 #include <vector>
-#include <set>
-#include <map>
 #include <queue>
 #include <algorithm>
 
+#include "../Common/CsrGraph.h"
+#include "../Common/BinaryGraphFormat.h"
+#include "../Common/DisjointSet.h"
+#include "../Common/Kruskal.h"
+#include "../Common/Boruvka.h"
+#include "../Common/Prim.h"
+
 class Edge {
 public:
     Edge() = default;
@@ -40,76 +45,63 @@ std::ostream& operator<<(std::ostream& out, const Edge& edge) {
     return out;
 }
 
-int findRoot(int node, std::vector<int>& parents) {    
-    while (node != parents[node]) {
-        node = parents[node];
+std::vector<Edge> findMSTUsingKruskal(std::vector<Edge>& edges, int numVertices, 
+                                      KruskalMode mode = KruskalMode::RadixSort) {
+    // helper containers
+    std::vector<Edge> msForest;
+    DisjointSet forest(numVertices);
+
+    if (mode == KruskalMode::RadixSort) {
+        // (weight, dest) packed into one key - the same order as operator>
+        runRadixSortKruskal(edges.size(), forest, 
+            [&edges](std::size_t i) { 
+                return toRadixKey(edges[i].getWeight()) << 32 | static_cast<std::uint32_t>(edges[i].getDest()); 
+            },
+            [&edges](std::size_t i) { return std::make_pair(edges[i].getSource(), edges[i].getDest()); },
+            [&edges, &msForest](std::size_t i) { msForest.push_back(edges[i]); });
+
+        return msForest;
     }
 
-    return node;
-}
-
-std::vector<Edge> findMSTUsingKruskal(std::vector<Edge>& edges, int numVertices) {
     // keeps edges ordered by smallest weight
     std::priority_queue<Edge, std::vector<Edge>, std::greater<Edge>> orderedEdges(edges.begin(), edges.end()); 
 
-    // helper containers
-    std::vector<Edge> msForest;
-    std::vector<int> parents(numVertices, 0);
-
-    for (int i = 0; i < parents.size(); i++) {
-        parents[i] = i;
-    }
-
     while (!orderedEdges.empty()) {
         Edge currentMinEdge = orderedEdges.top();
         orderedEdges.pop();
 
-        int src = currentMinEdge.getSource();
-        int dest = currentMinEdge.getDest();
-
-        int srcRoot = findRoot(src, parents);
-        int destRoot = findRoot(dest, parents);
-
-        if (srcRoot != destRoot) {
+        if (forest.unite(currentMinEdge.getSource(), currentMinEdge.getDest())) {
             msForest.push_back(currentMinEdge);
-            parents[destRoot] = srcRoot;
         }
     }
 
     return msForest;
 }
 
-void findMSTUsingPrim(int startNode, std::set<int>& graphNodes, std::map<int, std::vector<Edge>>& edgesByNode, 
-                      std::set<int>& visited, std::vector<Edge>& mstPrim) {
+// same forest in the same order as findMSTUsingKruskal, built by parallel Boruvka rounds
+std::vector<Edge> findMSTUsingBoruvka(std::vector<Edge>& edges, int numVertices, 
+                                      int numThreads = getDefaultNumThreads()) {
+    std::vector<std::uint32_t> forestEdges = findMSForestUsingBoruvka(edges.size(), numVertices,
+        [&edges](std::size_t i) { return std::make_pair(edges[i].getSource(), edges[i].getDest()); },
+        [&edges](std::size_t first, std::size_t second) { return edges[second] > edges[first]; },
+        numThreads);
 
-    visited.insert(startNode);
+    std::vector<Edge> msForest;
+    for (const std::uint32_t edgeIndex : forestEdges) {
+        msForest.push_back(edges[edgeIndex]);
+    }
 
-    std::priority_queue<Edge, std::vector<Edge>, std::greater<Edge>> 
-                        edges(edgesByNode[startNode].begin(), edgesByNode[startNode].end());
+    return msForest;
+}
 
-    while (!edges.empty()) {
-        Edge minEdge = edges.top();
-        edges.pop();
+void findMSTUsingPrim(int startNode, PrimMstBuilder<>& prim, const std::vector<Edge>& graphEdges, 
+                      std::vector<Edge>& mstPrim) {
 
-        int srcNode = minEdge.getSource();
-        int destNode = minEdge.getDest();
+    std::vector<int> treeEdgeIds;
+    prim.growTree(startNode, treeEdgeIds);
 
-        int nonTreeNode = -1;
-        if (visited.find(srcNode) != visited.end() && visited.find(destNode) == visited.end()) {
-            nonTreeNode = destNode;
-        
-        }
-        if (visited.find(destNode) != visited.end() && visited.find(srcNode) == visited.end()) {
-            nonTreeNode = srcNode;
-        }
-        
-        if (nonTreeNode != -1) {
-            mstPrim.push_back(minEdge);
-            visited.insert(nonTreeNode);
-            for (auto it = edgesByNode[nonTreeNode].begin(); it != edgesByNode[nonTreeNode].end(); it++) {
-                edges.push(*it);
-            }
-        }
+    for (const int edgeId : treeEdgeIds) {
+        mstPrim.push_back(graphEdges[edgeId]);
     }
 }
 
@@ -120,57 +112,69 @@ void printEdges(std::vector<Edge>& edges) {
     std::cout << std::endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     std::vector<Edge> graphEdges;
-    
-    graphEdges.emplace_back(0, 3, 9);
-    graphEdges.emplace_back(0, 5, 4);
-    graphEdges.emplace_back(0, 8, 5);
-    graphEdges.emplace_back(1, 4, 8);
-    graphEdges.emplace_back(1, 7, 7);
-    graphEdges.emplace_back(2, 6, 12);
-    graphEdges.emplace_back(3, 5, 2);
-    graphEdges.emplace_back(3, 6, 8);
-    graphEdges.emplace_back(3, 8, 20);
-    graphEdges.emplace_back(4, 7, 10);
-    graphEdges.emplace_back(6, 8, 7);
-
-    std::vector<Edge> expectedEdges = { 
-        graphEdges.at(6),
-        graphEdges.at(1),
-        graphEdges.at(2),
-        graphEdges.at(4),
-        graphEdges.at(10),
-        graphEdges.at(3),
-        graphEdges.at(5)
-    };
+    int numVertices = 9;
+
+    if (argc > 1) {
+        // MST of a binary (.csrg) or text graph file given on the command line
+        CsrGraph fileGraph = loadGraph(argv[1]);
+        for (const CsrEdge& edge : fileGraph.toEdgeList()) {
+            graphEdges.emplace_back(edge.from, edge.to, edge.weight);
+        }
+        numVertices = fileGraph.getNumNodes();
+    } else {
+        graphEdges.emplace_back(0, 3, 9);
+        graphEdges.emplace_back(0, 5, 4);
+        graphEdges.emplace_back(0, 8, 5);
+        graphEdges.emplace_back(1, 4, 8);
+        graphEdges.emplace_back(1, 7, 7);
+        graphEdges.emplace_back(2, 6, 12);
+        graphEdges.emplace_back(3, 5, 2);
+        graphEdges.emplace_back(3, 6, 8);
+        graphEdges.emplace_back(3, 8, 20);
+        graphEdges.emplace_back(4, 7, 10);
+        graphEdges.emplace_back(6, 8, 7);
+
+        std::vector<Edge> expectedEdges = { 
+            graphEdges.at(6),
+            graphEdges.at(1),
+            graphEdges.at(2),
+            graphEdges.at(4),
+            graphEdges.at(10),
+            graphEdges.at(3),
+            graphEdges.at(5)
+        };
+
+        printEdges(expectedEdges);
+    }
 
     // kruskal
-    int numVertices = 9;
     std::vector<Edge> mstKruskal = findMSTUsingKruskal(graphEdges, numVertices);
 
-    printEdges(expectedEdges);
     printEdges(mstKruskal);
 
+    // boruvka
+    std::vector<Edge> mstBoruvka = findMSTUsingBoruvka(graphEdges, numVertices);
+
+    printEdges(mstBoruvka);
+
     // prim
-    std::set<int> graphNodes;
-    std::map<int, std::vector<Edge>> edgesByNode;
+    std::vector<CsrEdge> csrEdges;
 
     for (const auto& edge : graphEdges) {
-        graphNodes.insert(edge.getSource());
-        graphNodes.insert(edge.getDest());
-
-        edgesByNode[edge.getSource()].push_back(edge);
-        edgesByNode[edge.getDest()].push_back(edge);
+        csrEdges.emplace_back(edge.getSource(), edge.getDest(), edge.getWeight());
     }
 
+    CsrGraph graph(numVertices, csrEdges, true);
+
     std::vector<Edge> primForest;
-    std::set<int> visited;
+    PrimMstBuilder<> prim(graph);
 
-    // run prim for each node
-    for (auto it = graphNodes.begin(); it != graphNodes.end(); it++) {
-        if (visited.find(*it) == visited.end()) {
-            findMSTUsingPrim(*it, graphNodes, edgesByNode, visited, primForest);
+    // run prim for each node that is not in a tree yet
+    for (int node = 0; node < graph.getNumNodes(); node++) {
+        if (!prim.isVisited(node) && graph.getOutDegree(node) > 0) {
+            findMSTUsingPrim(node, prim, graphEdges, primForest);
         }
     }
 
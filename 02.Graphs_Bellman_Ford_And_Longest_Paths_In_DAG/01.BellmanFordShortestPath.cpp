@@ -1,91 +1,56 @@
 #include <iostream>
 #include <string>
-#include <sstream>
 #include <vector>
+#include <limits>
 #include <numeric>
 #include <tuple>
 #include <algorithm>
 
-class Edge;
+#include "../Common/CsrGraph.h"
+#include "../Common/FastInputReader.h"
+#include "../Common/BinaryGraphFormat.h"
+#include "../Common/BellmanFord.h"
 
-using Graph = std::vector<Edge>;
-
-class Edge {
-public:
-    Edge() = default;
-
-    Edge(int src, int dest, int weight) : _src(src), _dest(dest), _weight(weight) {}
-
-    int getSource() const { return _src; }
-    int getDest() const { return _dest; }
-    int getWeight() const { return _weight; }
-
-    void setSource(const int src) { _src = src; }
-    void setDest(const int dest) { _dest = dest; }
-    void setWeight(const int weight) { _weight = weight; }
-
-private:
-    int _src{}, _dest{}, _weight{};
-};
+using Graph = CsrGraph;
 
 std::tuple<int, Graph, int, int> readInput() {
-    Graph graph;
+    FastInputReader reader;
 
-    int numNodes{}, numEdges{};
-    std::cin >> numNodes >> numEdges;
+    int numNodes = reader.readInt();
+    int numEdges = reader.readInt();
 
-    for (int i = 0; i < numEdges; i++) {
-        std::string line;
-        std::getline(std::cin >> std::ws, line);
-        std::istringstream istr(line);
+    std::vector<CsrEdge> edges = reader.readEdges(numEdges);
 
-        int src{}, dest{}, weight{};
-        istr >> src >> dest >> weight;
+    int startNode = reader.readInt();
+    int destNode = reader.readInt();
 
-        Edge currEdge(src, dest, weight);
-        graph.push_back(currEdge);
-    }
-
-    int startNode{}, destNode{};
-    std::cin >> startNode >> destNode;
+    // nodes are numbered from 1
+    Graph graph(numNodes + 1, edges);
 
     return std::make_tuple(numNodes, graph, startNode, destNode);
 }
 
-void runBellmanFordForGraphWithNegativeEdges(int numNodes, const Graph& graph, int startNode, int dest, 
-                                             std::vector<int>& distances, std::vector<int>& prevs) {
-    
-    distances[startNode] = 0;
-
-    for (int i = 0; i < numNodes - 1; i++) {
-        for (const Edge& edge : graph) {
-            int from = edge.getSource();
-            int to = edge.getDest();
-            int weight = edge.getWeight();
-
-            // relaxation step
-            if (distances[from] != std::numeric_limits<int>::max() &&
-                distances[from] + weight < distances[to]) {
-                
-                distances[to] = distances[from] + weight;
-                prevs[to] = from;
-            }
-        }
-    }
+// graph from a binary (.csrg) or text file given on the command line
+std::tuple<int, Graph, int, int> readInput(const std::string& graphPath, int startNode, int destNode) {
+    Graph graph = loadGraph(graphPath);
 
-    // detect negative cycles
-    for (const Edge& edge : graph) {
-        int from = edge.getSource();
-        int to = edge.getDest();
-        int weight = edge.getWeight();
-
-        if (distances[from] != std::numeric_limits<int>::max() &&
-            distances[from] + weight < distances[to]) {
-            
-            std::cerr << "Negative cycle detected!" << std::endl;
-            std::exit(EXIT_FAILURE);
-        }
+    return std::make_tuple(graph.getNumNodes() - 1, graph, startNode, destNode);
+}
+
+// a negative cycle is reported in the result, distances and prevs are not final then
+BellmanFordResult runBellmanFordForGraphWithNegativeEdges(int numNodes, const Graph& graph, int startNode, int dest,
+                                                          std::vector<int>& distances, std::vector<int>& prevs,
+                                                          BellmanFordMode mode = BellmanFordMode::Queue,
+                                                          int numThreads = getDefaultNumThreads()) {
+    return runBellmanFord(graph, startNode, distances, prevs, mode, numThreads);
+}
+
+void printNegativeCycle(const std::vector<int>& cycle) {
+    std::cerr << "Negative cycle detected: ";
+    for (const int node : cycle) {
+        std::cerr << node << " -> ";
     }
+    std::cerr << cycle.front() << std::endl;
 }
 
 std::vector<int> constructPathFromPrevIndices(std::vector<int>& prevs, int dest) {
@@ -108,9 +73,9 @@ int findWeightOfShortestPath(const Graph& graph, std::vector<int>& path) {
     int weight{};
     for (int i = 0; i < path.size() - 1; i++) {
         int src = path[i], dest = path[i + 1];
-        for (const Edge& edge : graph) {
-            if (edge.getSource() == src && edge.getDest() == dest) {
-                weight += edge.getWeight();
+        for (int arc = graph.getFirstArc(src); arc < graph.getLastArc(src); arc++) {
+            if (graph.getTarget(arc) == dest) {
+                weight += graph.getWeight(arc);
             }
         }
     }
@@ -125,13 +90,21 @@ void print(std::vector<int>& path) {
     std::cout << std::endl;
 }
 
-int main() {
-    const auto& [nodes, graph, startNode, destNode] = readInput();
+int main(int argc, char* argv[]) {
+    const auto& [nodes, graph, startNode, destNode] = argc > 3 ? readInput(argv[1], std::stoi(argv[2]), std::stoi(argv[3])) : readInput();
     
     std::vector<int> distances(nodes + 1, std::numeric_limits<int>::max());
     std::vector<int> prevs(nodes + 1, -1);
 
-    runBellmanFordForGraphWithNegativeEdges(nodes, graph, startNode, destNode, distances, prevs);
+    // an optional thread count after the graph arguments selects the edge-parallel passes
+    BellmanFordResult result = argc > 4
+        ? runBellmanFordForGraphWithNegativeEdges(nodes, graph, startNode, destNode, distances, prevs,
+                                                  BellmanFordMode::Parallel, std::stoi(argv[4]))
+        : runBellmanFordForGraphWithNegativeEdges(nodes, graph, startNode, destNode, distances, prevs);
+    if (result.hasNegativeCycle) {
+        printNegativeCycle(result.negativeCycle);
+        return EXIT_FAILURE;
+    }
 
     std::vector<int> shortestPath = constructPathFromPrevIndices(prevs, destNode);
 
@@ -1,91 +1,84 @@
 #include <iostream>
 #include <string>
-#include <sstream>
 #include <vector>
+#include <limits>
 #include <numeric>
 #include <tuple>
-#include <queue>
 
-using Graph = std::vector<std::vector<int>>;
+#include "../Common/CsrGraph.h"
+#include "../Common/FastInputReader.h"
+#include "../Common/BinaryGraphFormat.h"
+#include "../Common/TopologicalSort.h"
+#include "../Common/DagPaths.h"
 
-std::tuple<Graph, int, int> readInput() {
+using Graph = CsrGraph;
 
-    int numNodes{}, numEdges{};
-    std::cin >> numNodes >> numEdges;
+std::tuple<Graph, int, int> readInput() {
 
-    Graph graph(numNodes + 1, std::vector<int>(numNodes + 1, 0));
+    FastInputReader reader;
 
-    for (int i = 0; i < numEdges; i++) {
-        std::string line;
-        std::getline(std::cin >> std::ws, line);
-        std::istringstream istr(line);
+    int numNodes = reader.readInt();
+    int numEdges = reader.readInt();
 
-        int src{}, dest{}, weight{};
-        istr >> src >> dest >> weight;
+    std::vector<CsrEdge> edges = reader.readEdges(numEdges);
 
-        graph[src][dest] = weight;
-    }
+    int startNode = reader.readInt();
+    int destNode = reader.readInt();
 
-    int startNode{}, destNode{};
-    std::cin >> startNode >> destNode;
+    // nodes are numbered from 1
+    Graph graph(numNodes + 1, edges);
 
     return std::make_tuple(graph, startNode, destNode);
 }
 
-void topologicalSortOfDAGNodes(int startNode, std::deque<int>& sortedNodes, const Graph& graph, 
-                               std::vector<bool>& visited) {
-
-    if (visited[startNode]) {
-        return;
-    }
+// graph from a binary (.csrg) or text file given on the command line
+std::tuple<Graph, int, int> readInput(const std::string& graphPath, int startNode, int destNode, bool withReverse) {
+    Graph graph = loadGraph(graphPath, false, withReverse);
 
-    visited[startNode] = true;
-
-    for (int i = 1; i < graph[startNode].size(); i++) {
-        if (graph[startNode][i] != 0) {
-            topologicalSortOfDAGNodes(i, sortedNodes, graph, visited);
-        }
-    }
-
-    sortedNodes.push_back(startNode);
+    return std::make_tuple(graph, startNode, destNode);
 }
 
-void findLongestPathInDAG(const Graph& graph, int startNode, int dest, 
-                          std::vector<int>& distances, std::vector<int>& prevs) {
+// returns the cycle that makes the graph not a DAG, empty when the longest paths were found;
+// more than one thread relaxes the DAG level by level and needs the reverse CSR
+std::vector<int> findLongestPathInDAG(const Graph& graph, int startNode, int dest, 
+                                      std::vector<int>& distances, std::vector<int>& prevs, int numThreads = 1) {
     
-    distances[startNode] = 0;
-
-    std::deque<int> sortedNodes;
-
-    std::vector<bool> visited(graph.size(), false);
-
-    for (int i = 1; i < graph.size(); i++) {
-        topologicalSortOfDAGNodes(i, sortedNodes, graph, visited);
+    TopologicalOrder sortedNodes = sortTopologically(graph);
+    if (!sortedNodes.isDag()) {
+        return sortedNodes.cycle;
     }
 
-    while (!sortedNodes.empty()) {
-        int node = sortedNodes.back();
-        sortedNodes.pop_back();
-
-        for (int i = 1; i < graph[node].size(); i++) {
-            // relaxation step
-            int weight = graph[node][i];
-            if (weight != 0 && distances[i] < distances[node] + weight) {
-                distances[i] = distances[node] + weight;
-                prevs[i] = node;
-            }
-        }
+    if (numThreads > 1) {
+        relaxDagByLevels<MaxPlus<int>>(graph, sortedNodes, startNode, distances, prevs, numThreads);
+    } else {
+        relaxDagInTopologicalOrder<MaxPlus<int>>(graph, sortedNodes, startNode, distances, prevs);
     }
 
+    return {};
+}
+
+void printCycle(const std::vector<int>& cycle) {
+    std::cerr << "The graph is not a DAG, cycle: ";
+    for (const int node : cycle) {
+        std::cerr << node << " -> ";
+    }
+    std::cerr << cycle.front() << std::endl;
 }
 
-int main() {
-    const auto& [graph, startNode, destNode] = readInput();
+int main(int argc, char* argv[]) {
+    // an optional thread count after the graph arguments selects the level-parallel relaxation
+    int numThreads = argc > 4 ? std::stoi(argv[4]) : 1;
 
-    std::vector<int> distances(graph.size(), std::numeric_limits<int>::max() * -1);
-    std::vector<int> prevs(graph.size(), -1);
+    const auto& [graph, startNode, destNode] = argc > 3 ? readInput(argv[1], std::stoi(argv[2]), std::stoi(argv[3]), numThreads > 1) : readInput();
 
-    findLongestPathInDAG(graph, startNode, destNode, distances, prevs);
+    std::vector<int> distances(graph.getNumNodes(), MaxPlus<int>::zero());
+    std::vector<int> prevs(graph.getNumNodes(), -1);
+
+    std::vector<int> cycle = findLongestPathInDAG(graph, startNode, destNode, distances, prevs, numThreads);
+    if (!cycle.empty()) {
+        printCycle(cycle);
+        return EXIT_FAILURE;
+    }
 
     std::cout << "Longest path weight = " << distances[destNode] << std::endl;
 }
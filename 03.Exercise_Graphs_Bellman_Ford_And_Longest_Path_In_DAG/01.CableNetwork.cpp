@@ -1,129 +1,66 @@
 #include <iostream>
-#include <string>
-#include <sstream>
-#include <map>
-#include <queue>
-#include <functional>
 #include <vector>
 #include <tuple>
+#include <string>
 
-struct Edge;
-
-using GraphMap = std::unordered_map<int, std::vector<Edge>>;
-using PriorityQueue = std::priority_queue<Edge, std::vector<Edge>, std::function<bool(const Edge& e1, const Edge& e2)>>;
-
-struct Edge {
-    int from{};
-    int to{};
-    int weight{};
-
-    Edge() = default;
-
-    Edge(int src, int dest, int inWeight) : 
-        from(src), to(dest), weight(inWeight) {}
-
-    bool operator>(const Edge& other) {
-        return weight > other.weight;
-    }
-};
-
-int getNumberFromStream() {
-    int n;
-
-    std::string line, trash;
-    std::getline(std::cin >> std::ws, line);
-
-    std::istringstream istr(line);
+#include "../Common/CsrGraph.h"
+#include "../Common/FastInputReader.h"
+#include "../Common/CableNetwork.h"
 
-    istr >> trash >> n;
+std::tuple<CsrGraph, std::vector<bool>, int> readInput() {
+    FastInputReader reader;
 
-    return n;
-}
+    int budgest = reader.readInt();
+    int numNodes = reader.readInt();
+    int numEdges = reader.readInt();
 
-std::tuple<GraphMap, PriorityQueue, std::vector<bool>, int> readInput() {
-    int budgest = getNumberFromStream();
-    int numNodes = getNumberFromStream();
-    int numEdges = getNumberFromStream();
-
-    GraphMap graph;
-    PriorityQueue pq([](const Edge& e1, const Edge& e2) {
-        return e1.weight > e2.weight;
-    });
+    std::vector<CsrEdge> edges;
+    edges.reserve(numEdges);
 
     std::vector<bool> used(numNodes, false);
 
     for (int i = 0; i < numEdges; i++) {
-        std::string line;
-        std::getline(std::cin >> std::ws, line);
-        std::istringstream istr(line);
-        
-        std::string currToken;
-        
-        int counter{};
-        bool connected = false;
-        std::vector<int> edgeTokens;
-        while (istr >> currToken) {
-            counter++;
-            if (counter == 4) {
-                connected = true;
-                break;
-            }
-            edgeTokens.push_back(stoi(currToken));
-        }
+        int from = reader.readInt();
+        int to = reader.readInt();
+        int weight = reader.readInt();
 
-        int from = edgeTokens[0];
-        int to = edgeTokens[1];
-        int weight = edgeTokens[2];
+        // a trailing token ("connected") marks an existing cable
+        bool connected = reader.hasTokenOnLine();
+        reader.skipLine();
 
         if (connected) {
             used[from] = used[to] = true;
         }
 
-        Edge edge(from, to, weight);
-
-        if (graph.find(from) == graph.end()) {
-            graph[from].push_back(edge);
-        }
-
-        pq.push(edge);
+        edges.emplace_back(from, to, weight);
     }
 
-    return std::make_tuple(graph, pq, used, budgest);
-}
-
-void findMSForesCosttUsingPrim(GraphMap& graph, PriorityQueue& pqEdges, std::vector<bool>& used, int budget, int& cost) {
-
-    while (!pqEdges.empty()) {
-        Edge minEdge = pqEdges.top();
-        pqEdges.pop();
-
-        int removedValue = -1;
-
-        if (used[minEdge.from] && !used[minEdge.to]) {
-            used[minEdge.to] = true;
-            removedValue = minEdge.weight;
-        } else if (!used[minEdge.from] && used[minEdge.to]) {
-            used[minEdge.from] = true;  
-            removedValue = minEdge.weight;
-        }
+    CsrGraph graph(numNodes, edges, true);
 
-        if (removedValue != -1 && budget - removedValue > 0) {
-            budget -= removedValue;
-            cost += removedValue;
-        } else if (budget - removedValue < 0) {
-            return;
-        }
-    }
+    return std::make_tuple(graph, used, budgest);
+}
 
+// Prim from every connected node at once (Common/CableNetwork.h), the budget cuts the expansion order
+void findMSForesCosttUsingPrim(const BudgetedExpansion<>& expansion, int budget, int& cost) {
+    cost += static_cast<int>(expansion.findSpentBudget(budget));
 }
 
-int main() {
-    auto [graphMap, pq, used, budget] = readInput();
+// further budgets on the command line are answered from the same expansion
+int main(int argc, char* argv[]) {
+    auto [graphMap, used, budget] = readInput();
+
+    BudgetedExpansion<> expansion(graphMap, used);
 
     int cost{};
-    findMSForesCosttUsingPrim(graphMap, pq, used, budget, cost);
+    findMSForesCosttUsingPrim(expansion, budget, cost);
 
     std::cout << "Used budget: " << cost << std::endl;
 
+    for (int i = 1; i < argc; i++) {
+        long long whatIfBudget = std::stoll(argv[i]);
+        std::cout << "Budget " << whatIfBudget << ": used " << expansion.findSpentBudget(whatIfBudget) << ", "
+                  << expansion.findNumCables(whatIfBudget) << " new nodes" << std::endl;
+    }
+
     return 0;
 }
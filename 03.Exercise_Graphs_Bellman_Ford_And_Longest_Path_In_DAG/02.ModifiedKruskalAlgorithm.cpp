@@ -1,16 +1,17 @@
 #include <iostream>
 #include <string>
-#include <sstream>
-#include <map>
 #include <queue>
 #include <functional>
 #include <vector>
 #include <tuple>
-#include <numeric>
+
+#include "../Common/CsrGraph.h"
+#include "../Common/FastInputReader.h"
+#include "../Common/DisjointSet.h"
+#include "../Common/Kruskal.h"
 
 struct Edge;
 
-using GraphMap = std::unordered_map<int, std::vector<Edge>>;
 using PriorityQueue = std::priority_queue<Edge, std::vector<Edge>, std::function<bool(const Edge& e1, const Edge& e2)>>;
 
 struct Edge {
@@ -24,99 +25,74 @@ struct Edge {
         from(src), to(dest), weight(inWeight) {}
 };
 
-int getNumberFromStream() {
-    int n;
-
-    std::string line, trash;
-    std::getline(std::cin >> std::ws, line);
-
-    std::istringstream istr(line);
-
-    istr >> trash >> n;
-
-    return n;
-}
-
-std::tuple<GraphMap, PriorityQueue, std::vector<bool>> readInput() {
-    int numNodes = getNumberFromStream();
-    int numEdges = getNumberFromStream();
+std::tuple<CsrGraph, std::vector<Edge>, std::vector<bool>> readInput() {
+    FastInputReader reader;
 
-    GraphMap graph;
+    int numNodes = reader.readInt();
+    int numEdges = reader.readInt();
 
-    // priority_queue ordered in ascending order
-    PriorityQueue pq([](const Edge& e1, const Edge& e2) {
-        return e1.weight > e2.weight;
-    });
+    std::vector<CsrEdge> csrEdges;
+    std::vector<Edge> edges;
 
     std::vector<bool> used(numNodes, false);
 
     for (int i = 0; i < numEdges; i++) {
-        std::string line;
-        std::getline(std::cin >> std::ws, line);
-        std::istringstream istr(line);
+        auto [from, to, weight] = reader.readEdge();
 
-        int from{}, to{}, weight{};
-        istr >> from >> to >> weight;
+        csrEdges.emplace_back(from, to, weight);
+        edges.emplace_back(from, to, weight);
+    }
 
-        Edge edge(from, to, weight);
+    CsrGraph graph(numNodes, csrEdges, true);
 
-        if (graph.find(from) == graph.end()) {
-            graph[from].push_back(edge);
-        }
+    return std::make_tuple(graph, edges, used);
+}
 
-        pq.push(edge);
-    }
+void appendForestEdge(const Edge& edge, std::string& output, int& forestWeight) {
+    output.append("(").append(std::to_string(edge.from)).
+    append(" ").append(std::to_string(edge.to)).append(") -> ").
+    append(std::to_string(edge.weight)).append("\n");
 
-    return std::make_tuple(graph, pq, used);
+    forestWeight += edge.weight;
 }
 
-int findRoot(int node, std::vector<int>& parents) {
-    int root = parents[node];
+void findMSForestWeightUsingKruskal(const CsrGraph& graph, const std::vector<Edge>& edges, std::vector<bool>& used, 
+                                    DisjointSet& forest, std::string& output, int& forestWeight, 
+                                    KruskalMode mode = KruskalMode::RadixSort) {
 
-    while (parents[node] != root) {
-        root = parents[node];
-    }
+    if (mode == KruskalMode::RadixSort) {
+        runRadixSortKruskal(edges.size(), forest,
+            [&edges](std::size_t i) { return toRadixKey(edges[i].weight); },
+            [&edges](std::size_t i) { return std::make_pair(edges[i].from, edges[i].to); },
+            [&](std::size_t i) { appendForestEdge(edges[i], output, forestWeight); });
 
-    return root;
-}
+        return;
+    }
 
-void findMSForestWeightUsingKruskal(GraphMap& graph, PriorityQueue& pq, std::vector<bool>& used, 
-                                    std::vector<int>& parents, std::string& output, int& forestWeight) {
+    // priority_queue ordered in ascending order
+    PriorityQueue pq([](const Edge& e1, const Edge& e2) {
+        return e1.weight > e2.weight;
+    }, edges);
     
     while (!pq.empty()) {
         Edge minEdge = pq.top();
         pq.pop();
 
-        int fromRoot = findRoot(minEdge.from, parents);
-        int toRoot = findRoot(minEdge.to, parents);
-
-        if (fromRoot != toRoot) {
-            output.append("(").append(std::to_string(minEdge.from)).
-            append(" ").append(std::to_string(minEdge.to)).append(") -> ").
-            append(std::to_string(minEdge.weight)).append("\n");
-
-            forestWeight += minEdge.weight;
-            parents[toRoot] = fromRoot;
-
-            for (int i = 0; i < parents.size(); i++) {
-                if (parents[i] == toRoot) {
-                    parents[i] = fromRoot;
-                }
-            }
+        if (forest.unite(minEdge.from, minEdge.to)) {
+            appendForestEdge(minEdge, output, forestWeight);
         }
     }    
 }
 
 int main() {
-    auto [graph, pq, used] = readInput();
+    auto [graph, edges, used] = readInput();
 
-    std::vector<int> parents(used.size(), -1);
-    std::iota(parents.begin(), parents.end(), 0);
+    DisjointSet forest(static_cast<int>(used.size()));
 
     std::string output;
     int msForestWeigth{};
 
-    findMSForestWeightUsingKruskal(graph, pq, used, parents, output, msForestWeigth);
+    findMSForestWeightUsingKruskal(graph, edges, used, forest, output, msForestWeigth);
 
     std::cout << "\nMinimum spanning forest weight: " << msForestWeigth << std::endl;
 
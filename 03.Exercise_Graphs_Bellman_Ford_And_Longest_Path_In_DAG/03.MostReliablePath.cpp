@@ -1,107 +1,48 @@
 #include <iostream>
 #include <iomanip>
-#include <string>
-#include <sstream>
-#include <queue>
-#include <functional>
 #include <vector>
 #include <tuple>
 #include <stack>
 #include <numeric>
 
-struct Edge;
+#include "../Common/CsrGraph.h"
+#include "../Common/FastInputReader.h"
+#include "../Common/Semiring.h"
+#include "../Common/Dijkstra.h"
 
-using Graph = std::vector<std::vector<int>>;
-using PriorityQueue = std::priority_queue<int, std::vector<int>, std::function<bool(double, double)>>;
+// edge weights are the probabilities that the edges work, the reliability of a path is their product
+using Graph = BasicCsrGraph<double>;
 
 
-int getNumberFromStream() {
-    int n;
-
-    std::string line, trash;
-    std::getline(std::cin >> std::ws, line);
-
-    std::istringstream istr(line);
-
-    istr >> trash >> n;
-
-    return n;
-}
-
-std::pair<int, int> getStartAndEndNodes() {
-    int startNode{}, endNode{};
-
-    std::string line;
-    std::getline(std::cin >> std::ws, line);
-    std::istringstream istr(line);
-
-    std::string path, src, dash, dest;
-    istr >> path >> src >> dash >> dest;
-
-    startNode = stoi(src);
-    endNode = stoi(dest);
-
-    return std::make_pair(startNode, endNode);
-}
-
 std::tuple<Graph, int, int, int> readInput() {
-    int numNodes = getNumberFromStream();
-    auto [startNode, endNode] = getStartAndEndNodes();
-    int numEdges = getNumberFromStream();
-
-    Graph graph(numNodes, std::vector<int>(numNodes, 0));
-
-    for (int i = 0; i < numEdges; i++) {
-        std::string line;
-        std::getline(std::cin >> std::ws, line);
-        std::istringstream istr(line);
-
-        int from{}, to{}, weight{};
-        istr >> from >> to >> weight;
-
-        graph[from][to] = weight;
-        graph[to][from] = weight;
+    FastInputReader reader;
+
+    int numNodes = reader.readInt();
+    int startNode = reader.readInt();
+    int endNode = reader.readInt();
+    int numEdges = reader.readInt();
+
+    // reliabilities are given in percent
+    std::vector<Graph::Edge> edges;
+    edges.reserve(numEdges);
+    for (const CsrEdge& edge : reader.readEdges(numEdges)) {
+        edges.emplace_back(edge.from, edge.to, edge.weight / 100.00);
     }
 
+    Graph graph(numNodes, edges, true);
+
     return std::make_tuple(graph, startNode, endNode, numNodes);
 }
 
+// the most reliable path maximises a product of probabilities in [0, 1] - Dijkstra over the (max, *) semiring
 std::vector<int> findMostRiablePathInGraphUsingDijkstra(const Graph& graph, int startNode, int endNode, int numNodes) {
-    std::vector<double> distances(numNodes, 0.0);
-    std::vector<bool> visited(numNodes, false);
-    std::vector<int> prevs(numNodes, -1);
-
-    distances[startNode] = 100.00;
-
-    PriorityQueue pq([&distances](double first, double second) {
-        return distances[first] < distances[second];
-    });
-
-    pq.push(startNode);
+    std::vector<double> reliabilities;
+    std::vector<int> prevs;
 
-    while (!pq.empty()) {
-        int minNode = pq.top();
-        pq.pop();
-
-        visited[minNode] = true;
-
-        for (int i = 0; i < graph[minNode].size(); i++) {
-            int weight = graph[minNode][i];
-            if (weight != 0 && !visited[i]) {
-                double newDistance = distances[minNode] * weight / 100.00;
-
-                if (newDistance > distances[i]) {
-                    distances[i] = newDistance;
-                    prevs[i] = minNode;
-                }
-
-                pq.push(i);
-            }
-        }
-    }
+    runSemiringDijkstra<MaxTimes<double>>(graph, startNode, reliabilities, prevs);
 
     std::cout << "Most reliable path reliability: " << std::fixed 
-        << std::setprecision(2) << distances[endNode] << "%" << std::endl;
+        << std::setprecision(2) << reliabilities[endNode] * 100.00 << "%" << std::endl;
 
     return prevs;
 }
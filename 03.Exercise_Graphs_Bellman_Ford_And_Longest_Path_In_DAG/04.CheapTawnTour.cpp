@@ -1,12 +1,13 @@
 #include <iostream>
-#include <string>
-#include <sstream>
-#include <numeric>
 #include <queue>
 #include <functional>
 #include <vector>
 #include <tuple>
 
+#include "../Common/FastInputReader.h"
+#include "../Common/DisjointSet.h"
+#include "../Common/Kruskal.h"
+
 struct Edge;
 
 using PriorityQueue = std::priority_queue<Edge, std::vector<Edge>, std::function<bool(const Edge& e1, const Edge& e2)>>;
@@ -22,73 +23,58 @@ struct Edge {
         from(src), to(dest), weight(inWeight) {}
 };
 
-std::tuple<PriorityQueue, int> readInput() {
-    int numNodes{}, numEdges{};
+std::tuple<std::vector<Edge>, int> readInput() {
+    std::vector<Edge> edges;
 
-    PriorityQueue pq([](const Edge& e1, const Edge& e2) {
-        return e1.weight > e2.weight;
-    });
+    FastInputReader reader;
 
-    std::cin >> numNodes >> numEdges;
+    int numNodes = reader.readInt();
+    int numEdges = reader.readInt();
 
     for (int i = 0; i < numEdges; i++) {
-        std::string line;
-        std::getline(std::cin >> std::ws, line);
-        std::istringstream istr(line);
-        
-        char d1, d2;
-        int from{}, to{}, weight{};
-        istr >> from >> d1 >> to >> d2 >> weight;
+        // "from - to - weight", the dashes are skipped by the reader
+        auto [from, to, weight] = reader.readEdge();
  
-        Edge edge(from, to, weight);
-
-        pq.push(edge);
+        edges.emplace_back(from, to, weight);
     }
 
-    return std::make_tuple(pq, numNodes);
+    return std::make_tuple(edges, numNodes);
 }
 
-int findRoot(int node, std::vector<int>& parents) {
-    int root = parents[node];
+void findCheapestMSForestUsingKruskal(const std::vector<Edge>& edges, DisjointSet& forest, int& forestWeight, 
+                                      KruskalMode mode = KruskalMode::RadixSort) {
 
-    while (root != parents[node]) {
-        root = parents[root];
-    }
+    if (mode == KruskalMode::RadixSort) {
+        runRadixSortKruskal(edges.size(), forest,
+            [&edges](std::size_t i) { return toRadixKey(edges[i].weight); },
+            [&edges](std::size_t i) { return std::make_pair(edges[i].from, edges[i].to); },
+            [&edges, &forestWeight](std::size_t i) { forestWeight += edges[i].weight; });
 
-    return root;
-}
+        return;
+    }
 
-void findCheapestMSForestUsingKruskal(PriorityQueue& pq, std::vector<int>& parents, int& forestWeight) {
+    PriorityQueue pq([](const Edge& e1, const Edge& e2) {
+        return e1.weight > e2.weight;
+    }, edges);
     
     while (!pq.empty()) {
         Edge minEdge = pq.top();
         pq.pop();
 
-    	int srcRoot = findRoot(minEdge.from, parents);
-        int destRoot = findRoot(minEdge.to, parents);
-
-        if (srcRoot != destRoot) {
+        if (forest.unite(minEdge.from, minEdge.to)) {
             forestWeight += minEdge.weight;
-            parents[destRoot] = srcRoot;
-
-            for (int i = 0; i < parents.size(); i++) {
-                if (parents[i] == destRoot) {
-                    parents[i] = srcRoot;
-                }
-            }
         }
     }
 }
 
 int main() {
-    auto [pq, numNodes] = readInput();
+    auto [edges, numNodes] = readInput();
 
-    std::vector<int> parents(numNodes, -1);
-    std::iota(parents.begin(), parents.end(), 0);
+    DisjointSet forest(numNodes);
 
     int forestWeight{};
 
-    findCheapestMSForestUsingKruskal(pq, parents, forestWeight);
+    findCheapestMSForestUsingKruskal(edges, forest, forestWeight);
 
     std::cout << forestWeight << std::endl;
 
@@ -1,84 +1,44 @@
 #include <iostream>
-#include <string>
-#include <sstream>
+#include <limits>
 #include <numeric>
+#include <string>
 #include <vector>
 #include <stack>
 #include <tuple>
 
-using AdjMatrix = std::vector<std::vector<int>>;
-
-struct Edge {
-    int from{}, to{};
-    Edge() = default;
-    Edge(int iFrom, int iTo) : from(iFrom), to(iTo) {};
-};
-
-std::tuple<AdjMatrix, std::vector<Edge>, int, int> readInput() {
-    int numNodes{}, numEdges{};
-    std::cin >> numNodes >> numEdges;
+#include "../Common/CsrGraph.h"
+#include "../Common/FastInputReader.h"
+#include "../Common/BinaryGraphFormat.h"
+#include "../Common/BellmanFord.h"
 
-    AdjMatrix adjMatrix(numNodes + 1, std::vector<int>(numNodes + 1, 0));
+std::tuple<CsrGraph, int, int> readInput() {
+    FastInputReader reader;
 
-    std::vector<Edge> edges;
+    int numNodes = reader.readInt();
+    int numEdges = reader.readInt();
 
-    for (int i = 0; i < numEdges; i++) {
-        std::string line;
-        std::getline(std::cin >> std::ws, line);
-        std::istringstream istr(line);
-        
-        int from{}, to{}, weight{};
-        istr >> from >> to >> weight;
- 
-        adjMatrix[from][to] = weight;
-        adjMatrix[to][from] = weight;
+    std::vector<CsrEdge> edges = reader.readEdges(numEdges);
 
-        edges.emplace_back(from, to);
-    }
+    int startNode = reader.readInt();
+    int endNode = reader.readInt();
 
-    int startNode{}, endNode{};
-    std::cin >> startNode >> endNode;
+    // nodes are numbered from 1
+    CsrGraph graph(numNodes + 1, edges);
 
-    return std::make_tuple(adjMatrix, edges, startNode, endNode);
+    return std::make_tuple(graph, startNode, endNode);
 }
 
-int findRoot(int node, std::vector<int>& parents) {
-    int root = parents[node];
-
-    while (root != parents[node]) {
-        root = parents[root];
-    }
+// graph from a binary (.csrg) or text file given on the command line
+std::tuple<CsrGraph, int, int> readInput(const std::string& graphPath, int startNode, int destNode) {
+    CsrGraph graph = loadGraph(graphPath);
 
-    return root;
+    return std::make_tuple(graph, startNode, destNode);
 }
 
-void findShortestPathInGraphUsingBellmanFord(AdjMatrix& graph, std::vector<Edge>& edges, std::vector<int>& distances, 
-                                             std::vector<int>& prevs) {
-    
-    for (int i = 0; i < graph.size() - 1; i++) {
-        for (const auto [from, to] : edges) {
-            if (distances[from] != std::numeric_limits<int>::max()) {
-                int newDistance = distances[from] + graph[from][to];
-                if (newDistance < distances[to]) {
-                    distances[to] = newDistance;
-                    prevs[to] = from;
-                }
-            }   
-        }
-    }
-}
-
-bool detectNegativeCycle(AdjMatrix& graph, std::vector<Edge>& edges, std::vector<int>& distances) {
-    for (const auto& [from, to] : edges) {
-        if (distances[from] != std::numeric_limits<int>::max()) {
-            int newDistance = distances[from] + graph[from][to];
-            if (newDistance < distances[to]) {
-                return true;
-            }
-        }
-    }
-
-    return false;
+// early-terminating queue Bellman-Ford, a negative cycle is reported in the result
+BellmanFordResult findShortestPathInGraphUsingBellmanFord(const CsrGraph& graph, int startNode, std::vector<int>& distances,
+                                                          std::vector<int>& prevs) {
+    return runBellmanFord(graph, startNode, distances, prevs, BellmanFordMode::Queue);
 }
 
 std::stack<int> constructPathFromPrevIndices(int dest, std::vector<int>& prevs) {
@@ -104,19 +64,14 @@ void printPath(std::stack<int>& path) {
     std::cout << std::endl;
 }
 
-int main() {
-    auto [graph, edges, startNode, endNode] = readInput();
-
-    std::vector<int> distances(graph.size() + 1, std::numeric_limits<int>::max());
-    std::vector<int> parents(graph.size() + 1, -1);
-
-    distances[startNode] = 0;
+int main(int argc, char* argv[]) {
+    auto [graph, startNode, endNode] = argc > 3 ? readInput(argv[1], std::stoi(argv[2]), std::stoi(argv[3])) : readInput();
 
-    findShortestPathInGraphUsingBellmanFord(graph, edges, distances, parents);
+    std::vector<int> distances, parents;
 
-    bool hasNegativeCycle = detectNegativeCycle(graph, edges, distances);
+    BellmanFordResult result = findShortestPathInGraphUsingBellmanFord(graph, startNode, distances, parents);
 
-    if (hasNegativeCycle) {
+    if (result.hasNegativeCycle) {
         std::cout << "Undefined!" << std::endl;
     } else {
         std::stack<int> path = constructPathFromPrevIndices(endNode, parents);
@@ -1,80 +1,61 @@
 #include <iostream>
 #include <string>
-#include <sstream>
 #include <vector>
 #include <numeric>
 #include <tuple>
-#include <queue>
+#include <limits>
 #include <algorithm>
 
-using Graph = std::vector<std::vector<int>>;
+#include "../Common/CsrGraph.h"
+#include "../Common/FastInputReader.h"
+#include "../Common/BinaryGraphFormat.h"
+#include "../Common/TopologicalSort.h"
+#include "../Common/DagPaths.h"
 
-std::tuple<Graph, int, int> readInput() {
+using Graph = CsrGraph;
 
-    int numNodes{}, numEdges{};
-    std::cin >> numNodes >> numEdges;
+std::tuple<Graph, int, int> readInput() {
 
-    Graph graph(numNodes + 1, std::vector<int>(numNodes + 1, 0));
+    FastInputReader reader;
 
-    for (int i = 0; i < numEdges; i++) {
-        std::string line;
-        std::getline(std::cin >> std::ws, line);
-        std::istringstream istr(line);
+    int numNodes = reader.readInt();
+    int numEdges = reader.readInt();
 
-        int src{}, dest{}, weight{};
-        istr >> src >> dest >> weight;
+    std::vector<CsrEdge> edges = reader.readEdges(numEdges);
 
-        graph[src][dest] = weight;
-    }
+    int startNode = reader.readInt();
+    int destNode = reader.readInt();
 
-    int startNode{}, destNode{};
-    std::cin >> startNode >> destNode;
+    // nodes are numbered from 1
+    Graph graph(numNodes + 1, edges);
 
     return std::make_tuple(graph, startNode, destNode);
 }
 
-void sortDAGTopologicallyUsingDfs(int startNode, std::deque<int>& nodesToSort, 
-                                  const Graph& graph, std::vector<bool>& visisted) {
-    
-    if (visisted[startNode]) {
-        return;
-    }
+// graph from a binary (.csrg) or text file given on the command line
+std::tuple<Graph, int, int> readInput(const std::string& graphPath, int startNode, int destNode, bool withReverse) {
+    Graph graph = loadGraph(graphPath, false, withReverse);
 
-    visisted[startNode] = true;
-
-    for (int i = 0; i < graph[startNode].size(); i++) {
-        if (graph[startNode][i] != 0) {
-            sortDAGTopologicallyUsingDfs(i, nodesToSort, graph, visisted);
-        }
-    }
-
-    nodesToSort.push_back(startNode);
-} 
+    return std::make_tuple(graph, startNode, destNode);
+}
 
-void findLonegstPathInDAG(const Graph& graph, int startNode, int dest, 
-                          std::vector<int>& distances, std::vector<int>& prevs) {
+// returns the cycle that makes the graph not a DAG, empty when the longest paths were found;
+// more than one thread relaxes the DAG level by level and needs the reverse CSR
+std::vector<int> findLonegstPathInDAG(const Graph& graph, int startNode, int dest, 
+                                      std::vector<int>& distances, std::vector<int>& prevs, int numThreads = 1) {
     
-    distances[startNode] = 0;
-
-    std::deque<int> tSortedNodes;
-    std::vector<bool> visited(graph.size(), false);
-
-    for (int i = 0; i < graph.size(); i++) {
-        sortDAGTopologicallyUsingDfs(i, tSortedNodes, graph, visited);
+    TopologicalOrder tSortedNodes = sortTopologically(graph);
+    if (!tSortedNodes.isDag()) {
+        return tSortedNodes.cycle;
     }
 
-    while (!tSortedNodes.empty()) {
-        int node = tSortedNodes.back();
-        tSortedNodes.pop_back();
-
-        for (int i = 0; i < graph[node].size(); i++) {
-            int weight = graph[node][i];
-            if (weight != 0 && distances[i] < distances[node] + weight) {
-                distances[i] = distances[node] + weight;
-                prevs[i] = node;
-            }
-        }
+    if (numThreads > 1) {
+        relaxDagByLevels<MaxPlus<int>>(graph, tSortedNodes, startNode, distances, prevs, numThreads);
+    } else {
+        relaxDagInTopologicalOrder<MaxPlus<int>>(graph, tSortedNodes, startNode, distances, prevs);
     }
+
+    return {};
 }
 
 std::vector<int> constructPathFromPrevs(int dest, std::vector<int>& prevs) {
@@ -98,13 +79,28 @@ void printPath(std::vector<int>& path) {
     std::cout << std::endl;
 }
 
-int main() {
-    const auto& [graph, startNode, destNode] = readInput();
+void printCycle(const std::vector<int>& cycle) {
+    std::cerr << "The graph is not a DAG, cycle: ";
+    for (const int node : cycle) {
+        std::cerr << node << " -> ";
+    }
+    std::cerr << cycle.front() << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    // an optional thread count after the graph arguments selects the level-parallel relaxation
+    int numThreads = argc > 4 ? std::stoi(argv[4]) : 1;
 
-    std::vector<int> distances(graph.size(), std::numeric_limits<int>::max() * -1);
-    std::vector<int> prevs(graph.size(), -1);
+    const auto& [graph, startNode, destNode] = argc > 3 ? readInput(argv[1], std::stoi(argv[2]), std::stoi(argv[3]), numThreads > 1) : readInput();
 
-    findLonegstPathInDAG(graph, startNode, destNode, distances, prevs);
+    std::vector<int> distances(graph.getNumNodes(), MaxPlus<int>::zero());
+    std::vector<int> prevs(graph.getNumNodes(), -1);
+
+    std::vector<int> cycle = findLonegstPathInDAG(graph, startNode, destNode, distances, prevs, numThreads);
+    if (!cycle.empty()) {
+        printCycle(cycle);
+        return EXIT_FAILURE;
+    }
 
     std::vector<int> path = constructPathFromPrevs(destNode, prevs);
 
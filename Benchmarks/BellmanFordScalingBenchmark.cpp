@@ -0,0 +1,59 @@
+// Bellman-Ford on a G(n, m) graph with negative arcs (but no negative cycle):
+// the sequential pass and queue modes against the edge-parallel mode at
+// 1, 2, 4, 8 and 16 threads. The global pool is sized for 16 threads, so
+// every row really runs that many (oversubscribed on smaller machines).
+// Every run is checked against the pass mode.
+//
+// g++ -std=c++17 -O2 -pthread BellmanFordScalingBenchmark.cpp -o bellman_ford_scaling_benchmark
+// ./bellman_ford_scaling_benchmark [numNodes] [numEdges]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+
+#include "../Common/CsrGraph.h"
+#include "../Common/BellmanFord.h"
+#include "../Common/ThreadPool.h"
+#include "../Common/Stopwatch.h"
+#include "SyntheticGraphs.h"
+
+void report(const std::string& name, double elapsedMs, const BellmanFordResult& result, bool matches) {
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << elapsedMs << " ms" << std::setw(6) << result.numPasses << " passes"
+              << std::setw(12) << result.numRelaxations << " relaxations"
+              << (matches ? "" : "   MISMATCH") << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int numNodes = argc > 1 ? std::stoi(argv[1]) : 1000000;
+    int numEdges = argc > 2 ? std::stoi(argv[2]) : 8000000;
+
+    const std::vector<int> threadCounts = { 1, 2, 4, 8, 16 };
+    ThreadPool::configureGlobal(threadCounts.back());
+
+    std::vector<CsrEdge> edges = shiftWeightsByPotentials(generateRandomGraph(numNodes, numEdges, 1000), numNodes, 500);
+    CsrGraph graph(numNodes, edges);
+
+    std::cout << "G(n, m) with " << numNodes << " nodes, " << numEdges << " edges and negative arcs" << std::endl;
+
+    std::vector<int> expectedDistances, expectedPrevs;
+    Stopwatch stopwatch;
+    BellmanFordResult result = runBellmanFord(graph, 0, expectedDistances, expectedPrevs, BellmanFordMode::Passes);
+    report("passes", stopwatch.getElapsedMs(), result, true);
+
+    std::vector<int> distances, prevs;
+    stopwatch.restart();
+    result = runBellmanFord(graph, 0, distances, prevs, BellmanFordMode::Queue);
+    report("queue (SPFA)", stopwatch.getElapsedMs(), result, distances == expectedDistances && prevs == expectedPrevs);
+
+    for (const int numThreads : threadCounts) {
+        stopwatch.restart();
+        result = runBellmanFord(graph, 0, distances, prevs, BellmanFordMode::Parallel, numThreads);
+        report("parallel, " + std::to_string(numThreads) + " thread(s)", stopwatch.getElapsedMs(), result,
+               distances == expectedDistances && prevs == expectedPrevs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+// What-if budgets on one cable network: a budgeted Prim that is rerun for
+// every budget and stops at the first cable it can not pay for, against one
+// BudgetedExpansion (Common/CableNetwork.h) answering every budget with a
+// binary search over its prefix costs. The spent budgets are checked against
+// each other; the reruns only go through the first 50 budgets.
+//
+// g++ -std=c++17 -O2 CableBudgetBenchmark.cpp -o cable_budget_benchmark
+// ./cable_budget_benchmark [numNodes] [numEdges] [numBudgets]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "../Common/CsrGraph.h"
+#include "../Common/IndexedDaryHeap.h"
+#include "../Common/CableNetwork.h"
+#include "../Common/Stopwatch.h"
+#include "SyntheticGraphs.h"
+
+// multi-source Prim that lays cables while the budget stays positive
+long long runBudgetedPrim(const CsrGraph& graph, const std::vector<bool>& connected, long long budget) {
+    std::vector<bool> joined = connected;
+    IndexedDaryHeap<int, 4> frontier(graph.getNumNodes());
+
+    auto addCables = [&](int node) {
+        for (int arc = graph.getFirstArc(node); arc < graph.getLastArc(node); arc++) {
+            if (!joined[graph.getTarget(arc)]) {
+                frontier.pushOrDecrease(graph.getTarget(arc), graph.getWeight(arc));
+            }
+        }
+    };
+
+    for (int node = 0; node < graph.getNumNodes(); node++) {
+        if (joined[node]) {
+            addCables(node);
+        }
+    }
+
+    long long spent{};
+    while (!frontier.empty() && spent + frontier.topKey() < budget) {
+        spent += frontier.topKey();
+        int node = frontier.pop();
+        joined[node] = true;
+        addCables(node);
+    }
+
+    return spent;
+}
+
+void report(const std::string& name, double elapsedMs, int numBudgets, int mismatches) {
+    std::cout << std::left << std::setw(32) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << elapsedMs << " ms" << std::setw(14) << std::setprecision(3)
+              << 1000.0 * elapsedMs / numBudgets << " us/budget   mismatches: " << mismatches << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int numNodes = argc > 1 ? std::stoi(argv[1]) : 1000000;
+    int numEdges = argc > 2 ? std::stoi(argv[2]) : 4000000;
+    int numBudgets = argc > 3 ? std::stoi(argv[3]) : 10000;
+
+    CsrGraph graph(numNodes, generateRandomGraph(numNodes, numEdges, 1000), true);
+
+    // one connected node in a thousand, like an existing backbone
+    std::mt19937 rng(7);
+    std::vector<bool> connected(numNodes, false);
+    for (int i = 0; i < std::max(1, numNodes / 1000); i++) {
+        connected[std::uniform_int_distribution<int>(0, numNodes - 1)(rng)] = true;
+    }
+
+    Stopwatch stopwatch;
+    BudgetedExpansion<> expansion(graph, connected);
+    double buildMs = stopwatch.getElapsedMs();
+
+    long long fullCost = expansion.getCost(expansion.getNumCables());
+    std::uniform_int_distribution<long long> budgetDist(0, fullCost + 1);
+    std::vector<long long> budgets(numBudgets);
+    for (long long& budget : budgets) {
+        budget = budgetDist(rng);
+    }
+
+    std::cout << numNodes << " nodes, " << graph.getNumEdges() << " cables, " << expansion.getNumCables()
+              << " nodes to connect for " << fullCost << ", " << numBudgets << " budgets" << std::endl;
+
+    int numReruns = std::min(numBudgets, 50);
+    std::vector<long long> expected(numReruns);
+    stopwatch.restart();
+    for (int i = 0; i < numReruns; i++) {
+        expected[i] = runBudgetedPrim(graph, connected, budgets[i]);
+    }
+    report("budgeted Prim per budget", stopwatch.getElapsedMs(), numReruns, 0);
+
+    stopwatch.restart();
+    long long totalSpent{};
+    int mismatches{};
+    for (int i = 0; i < numBudgets; i++) {
+        long long spent = expansion.findSpentBudget(budgets[i]);
+        totalSpent += spent;
+        if (i < numReruns && spent != expected[i]) {
+            mismatches++;
+        }
+    }
+    report("prefix costs, binary search", stopwatch.getElapsedMs(), numBudgets, mismatches);
+
+    std::cout << "expansion built once in " << std::fixed << std::setprecision(1) << buildMs << " ms, " << totalSpent
+              << " spent over all budgets" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+// Contraction hierarchy on a grid "road network" or a graph file (e.g. a road
+// network converted with Tools/GraphConverter): preprocessing time and
+// shortcut count, a save / load round trip through the hierarchy file, then
+// query latency against bidirectional Dijkstra. Every distance is checked
+// against Dijkstra and every unpacked path is checked to be a real path of
+// that length.
+//
+// Grids are a hard case for contraction hierarchies (no road hierarchy, large
+// separators), so expect more shortcuts and a longer preprocessing than on
+// real road networks. An existing hierarchy file of a graph with the same
+// node count is loaded instead of rebuilt, see Tools/HierarchyBuilder.cpp.
+//
+// g++ -std=c++17 -O2 ContractionHierarchyBenchmark.cpp -o contraction_hierarchy_benchmark
+// ./contraction_hierarchy_benchmark [gridSide | graph.csrg] [numQueries] [hierarchyFile]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <limits>
+#include <utility>
+#include <cctype>
+#include <fstream>
+#include <algorithm>
+
+#include "../Common/CsrGraph.h"
+#include "../Common/Dijkstra.h"
+#include "../Common/PointToPointDijkstra.h"
+#include "../Common/ContractionHierarchy.h"
+#include "../Common/BinaryGraphFormat.h"
+#include "../Common/Stopwatch.h"
+#include "SyntheticGraphs.h"
+
+// weight of the path in the graph, -1 when two consecutive nodes are not adjacent
+long long findPathWeight(const CsrGraph& graph, const std::vector<int>& path) {
+    long long weight{};
+    for (std::size_t i = 0; i + 1 < path.size(); i++) {
+        int cheapest = std::numeric_limits<int>::max();
+        for (int arc = graph.getFirstArc(path[i]); arc < graph.getLastArc(path[i]); arc++) {
+            if (graph.getTarget(arc) == path[i + 1]) {
+                cheapest = std::min(cheapest, graph.getWeight(arc));
+            }
+        }
+        if (cheapest == std::numeric_limits<int>::max()) {
+            return -1;
+        }
+        weight += cheapest;
+    }
+    return weight;
+}
+
+template <typename Query>
+void measure(const std::string& name, const CsrGraph& graph, const std::vector<std::pair<int, int>>& queries,
+             const std::vector<int>& expectedDistances, Query query) {
+    long long totalSettled{};
+    std::vector<PointToPointResult> results(queries.size());
+
+    Stopwatch stopwatch;
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        results[i] = query(queries[i].first, queries[i].second);
+        totalSettled += results[i].numSettled;
+    }
+    double elapsedMs = stopwatch.getElapsedMs();
+
+    int mismatches{};
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        const PointToPointResult& result = results[i];
+        bool pathMatches = result.path.empty() || findPathWeight(graph, result.path) == result.distance;
+        if (result.distance != expectedDistances[i] || !pathMatches) {
+            mismatches++;
+        }
+    }
+
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << static_cast<double>(totalSettled) / queries.size() << " settled"
+              << std::setw(12) << 1000.0 * elapsedMs / queries.size() << " us/query"
+              << "   wrong results: " << mismatches << std::endl;
+}
+
+bool isNumber(const std::string& text) {
+    return !text.empty() && std::all_of(text.begin(), text.end(), [](unsigned char ch) { return std::isdigit(ch); });
+}
+
+bool fileExists(const std::string& path) {
+    return std::ifstream(path).good();
+}
+
+int main(int argc, char* argv[]) {
+    std::string graphArgument = argc > 1 ? argv[1] : "300";
+    int numQueries = argc > 2 ? std::stoi(argv[2]) : 1000;
+    std::string hierarchyFile = argc > 3 ? argv[3] : "graph.chg";
+
+    CsrGraph graph;
+    if (isNumber(graphArgument)) {
+        int side = std::stoi(graphArgument);
+        graph = CsrGraph(side * side, generateGridGraph(side, side, 10, 30), true);
+        std::cout << side << " x " << side << " grid";
+    } else {
+        graph = loadGraph(graphArgument, false, true);
+        std::cout << graphArgument;
+    }
+    std::cout << ", " << graph.getNumNodes() << " nodes, " << graph.getNumArcs() << " arcs, "
+              << numQueries << " random queries" << std::endl;
+
+    Stopwatch stopwatch;
+    ContractionHierarchy hierarchy;
+    if (fileExists(hierarchyFile) && loadContractionHierarchy(hierarchyFile).getNumNodes() == graph.getNumNodes()) {
+        hierarchy = loadContractionHierarchy(hierarchyFile);
+        std::cout << "hierarchy loaded from " << hierarchyFile << " in " << std::fixed << std::setprecision(1)
+                  << stopwatch.getElapsedMs() << " ms, " << hierarchy.getNumShortcuts() << " shortcuts" << std::endl;
+    } else {
+        ContractionHierarchy builtHierarchy = buildContractionHierarchy(graph);
+        std::cout << "preprocessing " << std::fixed << std::setprecision(1) << stopwatch.getElapsedMs() << " ms, "
+                  << builtHierarchy.getNumShortcuts() << " shortcuts" << std::endl;
+
+        saveContractionHierarchy(builtHierarchy, hierarchyFile);
+        stopwatch.restart();
+        hierarchy = loadContractionHierarchy(hierarchyFile);
+        std::cout << "saved to " << hierarchyFile << ", loaded again in " << stopwatch.getElapsedMs() << " ms" << std::endl;
+    }
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> nodeDist(0, graph.getNumNodes() - 1);
+    std::vector<std::pair<int, int>> queries(numQueries);
+    for (auto& query : queries) {
+        query = { nodeDist(rng), nodeDist(rng) };
+    }
+
+    std::vector<int> expectedDistances(numQueries);
+    std::vector<int> distances, prevs;
+    for (int i = 0; i < numQueries; i++) {
+        runDijkstra(graph, queries[i].first, distances, prevs, queries[i].second);
+        expectedDistances[i] = distances[queries[i].second];
+    }
+
+    PointToPointDijkstra<> dijkstra(graph);
+    measure("bidirectional Dijkstra", graph, queries, expectedDistances, [&](int start, int dest) {
+        return dijkstra.findBidirectional(start, dest);
+    });
+
+    ContractionHierarchyQuery query(hierarchy);
+    measure("CH, distance only", graph, queries, expectedDistances, [&](int start, int dest) {
+        return query.findShortestPath(start, dest, false);
+    });
+
+    measure("CH, distance and path", graph, queries, expectedDistances, [&](int start, int dest) {
+        return query.findShortestPath(start, dest);
+    });
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+// One-to-all shortest paths: sequential Dijkstra against delta-stepping
+// (Common/DeltaStepping.h) with the auto-tuned delta on 1, 2, 4, ... threads
+// up to numThreads, and with a few fixed deltas on all threads. The graphs are
+// a grid road network, a directed G(n, m) graph and a G(n, m) graph with
+// weights 0..15, whose many zero-weight arcs and equal distances test the
+// prevs the hardest. Distances and prevs have to be identical to Dijkstra's.
+//
+// g++ -std=c++17 -O2 -pthread DeltaSteppingBenchmark.cpp -o delta_stepping_benchmark
+// ./delta_stepping_benchmark [numNodes] [numThreads] [numSources]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <cmath>
+
+#include "../Common/CsrGraph.h"
+#include "../Common/Dijkstra.h"
+#include "../Common/DeltaStepping.h"
+#include "../Common/Stopwatch.h"
+#include "SyntheticGraphs.h"
+
+void report(const std::string& name, double elapsedMs, double dijkstraMs, int numSources, int mismatches) {
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << elapsedMs / numSources << " ms/run" << std::setw(8) << std::setprecision(2)
+              << dijkstraMs / elapsedMs << "x   mismatches: " << mismatches << std::endl;
+}
+
+void runSources(const std::string& name, int numNodes, const std::vector<CsrEdge>& edges, bool undirected,
+                int maxThreads, int numSources) {
+    CsrGraph graph(numNodes, edges, undirected);
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> nodeDist(0, numNodes - 1);
+    std::vector<int> sources;
+    for (int i = 0; i < numSources; i++) {
+        sources.push_back(nodeDist(rng));
+    }
+
+    std::vector<std::vector<int>> expectedDistances(numSources), expectedPrevs(numSources);
+    Stopwatch stopwatch;
+    for (int i = 0; i < numSources; i++) {
+        runDijkstra(graph, sources[i], expectedDistances[i], expectedPrevs[i]);
+    }
+    double dijkstraMs = stopwatch.getElapsedMs();
+
+    std::cout << name << ": " << numNodes << " nodes, " << edges.size() << " edges, auto delta "
+              << chooseDeltaStepWidth(graph) << std::endl;
+    report("  Dijkstra", dijkstraMs, dijkstraMs, numSources, 0);
+
+    auto runDeltaStepping = [&](const std::string& variant, int delta, int numThreads) {
+        DeltaStepping<> solver(graph, delta, numThreads);
+        std::vector<int> distances, prevs;
+        int mismatches{};
+
+        stopwatch.restart();
+        for (int i = 0; i < numSources; i++) {
+            solver.run(sources[i], distances, prevs);
+            mismatches += distances != expectedDistances[i] || prevs != expectedPrevs[i];
+        }
+        report("  " + variant, stopwatch.getElapsedMs(), dijkstraMs, numSources, mismatches);
+    };
+
+    for (int numThreads = 1; numThreads < 2 * maxThreads; numThreads *= 2) {
+        numThreads = std::min(numThreads, maxThreads);
+        runDeltaStepping("delta auto, " + std::to_string(numThreads) + " threads", 0, numThreads);
+    }
+    for (const int delta : { 1, 10, 100, 1000 }) {
+        runDeltaStepping("delta " + std::to_string(delta) + ", " + std::to_string(maxThreads) + " threads", delta,
+                         maxThreads);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int numNodes = argc > 1 ? std::stoi(argv[1]) : 1000000;
+    int numThreads = argc > 2 ? std::stoi(argv[2]) : getDefaultNumThreads();
+    int numSources = argc > 3 ? std::stoi(argv[3]) : 5;
+
+    ThreadPool::configureGlobal(numThreads);
+
+    int side = static_cast<int>(std::sqrt(numNodes));
+    runSources("grid", side * side, generateGridGraph(side, side, 1, 100), true, numThreads, numSources);
+    runSources("G(n, m)", numNodes, generateRandomGraph(numNodes, 4 * numNodes, 1000), false, numThreads,
+               numSources);
+
+    // weights 0..15: a sixteenth of the arcs costs nothing
+    std::vector<CsrEdge> zeroWeightEdges = generateRandomGraph(numNodes, 4 * numNodes, 16);
+    for (CsrEdge& edge : zeroWeightEdges) {
+        edge.weight--;
+    }
+    runSources("G(n, m), zero weights", numNodes, zeroWeightEdges, false, numThreads, numSources);
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Compares the indexed d-ary heap Dijkstra with the original lazy
+// std::priority_queue<int, ..., std::function<bool(int, int)>> version.
+//
+// g++ -std=c++17 -O2 DijkstraHeapBenchmark.cpp -o dijkstra_heap_benchmark
+// ./dijkstra_heap_benchmark [numNodes] [numEdges]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <queue>
+#include <limits>
+#include <functional>
+
+#include "../Common/CsrGraph.h"
+#include "../Common/Dijkstra.h"
+#include "SyntheticGraphs.h"
+#include "../Common/Stopwatch.h"
+
+using PriorityQueue = std::priority_queue<int, std::vector<int>, std::function<bool(int, int)>>;
+
+// the queue as it was in findShortestPathUsingDijkstra - one push per relaxed edge
+void runLazyDijkstra(const CsrGraph& graph, int startNode, std::vector<int>& distances, std::vector<int>& prevs) {
+    distances.assign(graph.getNumNodes(), std::numeric_limits<int>::max());
+    prevs.assign(graph.getNumNodes(), -1);
+    std::vector<bool> visited(graph.getNumNodes(), false);
+
+    distances[startNode] = 0;
+
+    PriorityQueue prQueue([&distances](int node1, int node2) {
+        return distances[node1] > distances[node2];
+    });
+
+    prQueue.push(startNode);
+
+    while (!prQueue.empty()) {
+        int minParentNode = prQueue.top();
+        prQueue.pop();
+
+        visited[minParentNode] = true;
+
+        for (int arc = graph.getFirstArc(minParentNode); arc < graph.getLastArc(minParentNode); arc++) {
+            int child = graph.getTarget(arc);
+            if (!visited[child]) {
+                prQueue.push(child);
+
+                int newDistance = distances[minParentNode] + graph.getWeight(arc);
+                if (newDistance < distances[child]) {
+                    distances[child] = newDistance;
+                    prevs[child] = minParentNode;
+                }
+            }
+        }
+    }
+}
+
+template <typename Run>
+void measure(const std::string& name, Run run, const std::vector<int>& reference, int repetitions) {
+    std::vector<int> distances, prevs;
+
+    Stopwatch stopwatch;
+    for (int i = 0; i < repetitions; i++) {
+        run(distances, prevs);
+    }
+    double elapsedMs = stopwatch.getElapsedMs() / repetitions;
+
+    int mismatches{};
+    for (int node = 0; node < static_cast<int>(reference.size()); node++) {
+        if (distances[node] != reference[node]) {
+            mismatches++;
+        }
+    }
+
+    std::cout << std::left << std::setw(28) << name << std::right << std::setw(10) << std::fixed
+              << std::setprecision(2) << elapsedMs << " ms   wrong distances: " << mismatches << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int numNodes = argc > 1 ? std::stoi(argv[1]) : 250000;
+    int numEdges = argc > 2 ? std::stoi(argv[2]) : 2000000;
+    int repetitions = 3;
+
+    CsrGraph graph(numNodes, generateRandomGraph(numNodes, numEdges, 1000));
+
+    std::cout << "G(n, m) with " << numNodes << " nodes and " << graph.getNumArcs() << " arcs" << std::endl;
+
+    std::vector<int> reference, referencePrevs;
+    runDijkstra<2>(graph, 0, reference, referencePrevs);
+
+    measure("lazy std::function queue", [&](std::vector<int>& d, std::vector<int>& p) {
+        runLazyDijkstra(graph, 0, d, p);
+    }, reference, repetitions);
+
+    measure("indexed binary heap", [&](std::vector<int>& d, std::vector<int>& p) {
+        runDijkstra<2>(graph, 0, d, p);
+    }, reference, repetitions);
+
+    measure("indexed 4-ary heap", [&](std::vector<int>& d, std::vector<int>& p) {
+        runDijkstra<4>(graph, 0, d, p);
+    }, reference, repetitions);
+
+    measure("indexed 8-ary heap", [&](std::vector<int>& d, std::vector<int>& p) {
+        runDijkstra<8>(graph, 0, d, p);
+    }, reference, repetitions);
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+// Many-to-many distance table on a grid "road network": one fresh one-to-all
+// Dijkstra per source (new distance / prev vectors every call) against
+// computeDistanceTable with reused scratch at different thread counts.
+// Throughput is reported in sources per second; every table is checked
+// against the per-source Dijkstra.
+//
+// g++ -std=c++17 -O2 -pthread DistanceTableBenchmark.cpp -o distance_table_benchmark
+// ./distance_table_benchmark [gridSide] [numSources] [numTargets]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+
+#include "../Common/CsrGraph.h"
+#include "../Common/Dijkstra.h"
+#include "../Common/DistanceTable.h"
+#include "../Common/Parallel.h"
+#include "../Common/Stopwatch.h"
+#include "SyntheticGraphs.h"
+
+void report(const std::string& name, double elapsedMs, int numSources, int mismatches) {
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << elapsedMs << " ms" << std::setw(12) << 1000.0 * numSources / elapsedMs
+              << " sources/s   wrong distances: " << mismatches << std::endl;
+}
+
+int countMismatches(const DistanceMatrix& table, const DistanceMatrix& expected) {
+    int mismatches{};
+    for (int row = 0; row < expected.getNumRows(); row++) {
+        for (int column = 0; column < expected.getNumColumns(); column++) {
+            if (table.get(row, column) != expected.get(row, column)) {
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
+
+int main(int argc, char* argv[]) {
+    int side = argc > 1 ? std::stoi(argv[1]) : 500;
+    int numSources = argc > 2 ? std::stoi(argv[2]) : 200;
+    int numTargets = argc > 3 ? std::stoi(argv[3]) : 200;
+
+    CsrGraph graph(side * side, generateGridGraph(side, side, 10, 30), true);
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> nodeDist(0, graph.getNumNodes() - 1);
+    std::vector<int> sources(numSources), targets(numTargets);
+    for (int& source : sources) {
+        source = nodeDist(rng);
+    }
+    for (int& target : targets) {
+        target = nodeDist(rng);
+    }
+
+    std::cout << side << " x " << side << " grid, " << numSources << " x " << numTargets << " table" << std::endl;
+
+    Stopwatch stopwatch;
+    DistanceMatrix expected(numSources, numTargets);
+    for (int row = 0; row < numSources; row++) {
+        std::vector<int> distances, prevs;
+        runDijkstra(graph, sources[row], distances, prevs);
+        for (int column = 0; column < numTargets; column++) {
+            expected.set(row, column, distances[targets[column]]);
+        }
+    }
+    report("one-to-all per source", stopwatch.getElapsedMs(), numSources, 0);
+
+    for (int numThreads = 1; numThreads <= getDefaultNumThreads(); numThreads *= 2) {
+        stopwatch.restart();
+        DistanceMatrix table = computeDistanceTable(graph, sources, targets, numThreads);
+        report("table, " + std::to_string(numThreads) + " thread(s)", stopwatch.getElapsedMs(), numSources,
+               countMismatches(table, expected));
+    }
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+// Minimum spanning forest under a stream of edge insertions and deletions:
+// DynamicMinimumSpanningForest (Common/DynamicMst.h) against a radix-sort
+// Kruskal from scratch. Every update is a deletion - half of them of a
+// forest edge, which needs a replacement search - or an insertion of a
+// random edge. Every checkInterval updates the forest is compared edge by
+// edge with Kruskal over the live edges in id order.
+//
+// g++ -std=c++17 -O2 -pthread DynamicMstBenchmark.cpp -o dynamic_mst_benchmark
+// ./dynamic_mst_benchmark [numNodes] [numEdges] [numUpdates] [checkInterval]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "../Common/CsrGraph.h"
+#include "../Common/DisjointSet.h"
+#include "../Common/Kruskal.h"
+#include "../Common/DynamicMst.h"
+#include "../Common/Stopwatch.h"
+#include "SyntheticGraphs.h"
+
+// forest edge ids of Kruskal over the live edges, ascending
+std::vector<int> runKruskal(const DynamicMinimumSpanningForest<>& dynamicForest, int numIds, long long& totalWeight) {
+    std::vector<int> ids;
+    for (int id = 0; id < numIds; id++) {
+        if (dynamicForest.isAlive(id)) {
+            ids.push_back(id);
+        }
+    }
+
+    DisjointSet forest(dynamicForest.getNumNodes());
+    std::vector<int> forestIds;
+    totalWeight = 0;
+    runRadixSortKruskal(ids.size(), forest,
+        [&](std::size_t i) { return toRadixKey(dynamicForest.getEdge(ids[i]).weight); },
+        [&](std::size_t i) { return std::make_pair(dynamicForest.getEdge(ids[i]).from, dynamicForest.getEdge(ids[i]).to); },
+        [&](std::size_t i) {
+            forestIds.push_back(ids[i]);
+            totalWeight += dynamicForest.getEdge(ids[i]).weight;
+        });
+
+    std::sort(forestIds.begin(), forestIds.end());
+    return forestIds;
+}
+
+int main(int argc, char* argv[]) {
+    int numNodes = argc > 1 ? std::stoi(argv[1]) : 1000000;
+    int numEdges = argc > 2 ? std::stoi(argv[2]) : 5000000;
+    int numUpdates = argc > 3 ? std::stoi(argv[3]) : 100000;
+    int checkInterval = argc > 4 ? std::stoi(argv[4]) : 25000;
+
+    std::vector<CsrEdge> edges = generateRandomGraph(numNodes, numEdges, 1000);
+
+    Stopwatch stopwatch;
+    DynamicMinimumSpanningForest<> dynamicForest(numNodes, edges);
+    std::cout << numNodes << " nodes, " << numEdges << " edges, initial forest of "
+              << dynamicForest.getNumForestEdges() << " edges built in " << std::fixed << std::setprecision(1)
+              << stopwatch.getElapsedMs() << " ms" << std::endl;
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> nodeDist(0, numNodes - 1);
+    std::uniform_int_distribution<int> weightDist(1, 1000);
+    // deletions pick among the initial ids, insertions reuse the freed ones
+    std::uniform_int_distribution<int> idDist(0, numEdges - 1);
+
+    double updateMs{}, kruskalMs{};
+    int numChecks{}, mismatches{}, numForestDeletions{};
+    for (int update = 1; update <= numUpdates; update++) {
+        stopwatch.restart();
+        if (update % 2 == 0) {
+            dynamicForest.addEdge(nodeDist(rng), nodeDist(rng), weightDist(rng));
+        } else {
+            bool forestEdge = update % 4 == 1;
+            // gives up on the kind after some draws, a sparse graph may have no non-forest edges
+            int id = idDist(rng);
+            for (int draw = 0; !dynamicForest.isAlive(id) || (draw < 64 && dynamicForest.isInForest(id) != forestEdge);
+                 draw++) {
+                id = idDist(rng);
+            }
+            numForestDeletions += dynamicForest.isInForest(id);
+            dynamicForest.removeEdge(id);
+        }
+        updateMs += stopwatch.getElapsedMs();
+
+        if (update % checkInterval == 0 || update == numUpdates) {
+            stopwatch.restart();
+            long long expectedWeight;
+            std::vector<int> expected = runKruskal(dynamicForest, numEdges, expectedWeight);
+            kruskalMs += stopwatch.getElapsedMs();
+            numChecks++;
+
+            if (expected != dynamicForest.getForestEdgeIds() || expectedWeight != dynamicForest.getTotalWeight()) {
+                mismatches++;
+            }
+        }
+    }
+
+    std::cout << numUpdates << " updates (" << numForestDeletions << " forest edge deletions)" << std::endl;
+    std::cout << std::left << std::setw(28) << "dynamic forest" << std::right << std::setw(12)
+              << 1000.0 * updateMs / numUpdates << " us/update" << std::endl;
+    std::cout << std::left << std::setw(28) << "Kruskal from scratch" << std::right << std::setw(12)
+              << 1000.0 * kruskalMs / numChecks << " us/update" << std::endl;
+    std::cout << "forest weight " << dynamicForest.getTotalWeight() << ", " << numChecks << " checks, mismatches: "
+              << mismatches << std::endl;
+
+    return 0;
+}
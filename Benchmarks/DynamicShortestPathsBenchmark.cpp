@@ -0,0 +1,117 @@
+// One-to-all shortest paths under a stream of weight changes: Dijkstra from
+// scratch after every change against DynamicShortestPaths
+// (Common/DynamicShortestPaths.h) repairing only what changed. Each update
+// changes batchSize random edges - half of them heavier, half lighter - on a
+// grid road network and on a directed G(n, m) graph. After every
+// checkInterval updates the repaired distances are compared with a fresh
+// Dijkstra and every prev is checked to be the end of a shortest arc.
+//
+// g++ -std=c++17 -O2 DynamicShortestPathsBenchmark.cpp -o dynamic_shortest_paths_benchmark
+// ./dynamic_shortest_paths_benchmark [numNodes] [numUpdates] [batchSize] [checkInterval]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <cmath>
+
+#include "../Common/CsrGraph.h"
+#include "../Common/Dijkstra.h"
+#include "../Common/DynamicShortestPaths.h"
+#include "../Common/Stopwatch.h"
+#include "SyntheticGraphs.h"
+
+// wrong distances plus prevs that are not on a shortest arc
+int countMismatches(const std::vector<CsrEdge>& edges, bool undirected, const std::vector<int>& distances,
+                    const std::vector<int>& prevs, const std::vector<int>& expected) {
+    int mismatches{};
+    for (std::size_t node = 0; node < expected.size(); node++) {
+        mismatches += distances[node] != expected[node];
+    }
+
+    const int INF = MinPlus<int>::zero();
+    std::vector<bool> prevOk(distances.size(), false);
+    for (const CsrEdge& edge : edges) {
+        for (int direction = 0; direction < (undirected ? 2 : 1); direction++) {
+            int from = direction == 0 ? edge.from : edge.to;
+            int to = direction == 0 ? edge.to : edge.from;
+            if (prevs[to] == from && distances[from] != INF && distances[from] + edge.weight == distances[to]) {
+                prevOk[to] = true;
+            }
+        }
+    }
+    for (std::size_t node = 0; node < prevs.size(); node++) {
+        mismatches += prevs[node] != -1 && !prevOk[node];
+    }
+
+    return mismatches;
+}
+
+void runUpdates(const std::string& name, int numNodes, std::vector<CsrEdge> edges, bool undirected, int numUpdates,
+                int batchSize, int checkInterval) {
+    CsrGraph graph(numNodes, edges, undirected, !undirected);
+
+    Stopwatch stopwatch;
+    DynamicShortestPaths<> paths(graph, 0);
+    double initialMs = stopwatch.getElapsedMs();
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> edgeDist(0, static_cast<int>(edges.size()) - 1);
+    std::uniform_real_distribution<double> factorDist(1.0, 3.0);
+
+    double updateMs{}, dijkstraMs{};
+    long long touchedNodes{};
+    int numChecks{}, mismatches{};
+    std::vector<int> distances, prevs;
+
+    for (int update = 1; update <= numUpdates; update++) {
+        std::vector<std::pair<int, int>> changes;
+        for (int i = 0; i < batchSize; i++) {
+            int id = edgeDist(rng);
+            double factor = factorDist(rng);
+            int weight = static_cast<int>(i % 2 == 0 ? edges[id].weight * factor : edges[id].weight / factor);
+            edges[id].weight = std::max(1, weight);
+            changes.emplace_back(id, edges[id].weight);
+        }
+
+        stopwatch.restart();
+        paths.changeWeights(changes);
+        updateMs += stopwatch.getElapsedMs();
+        touchedNodes += paths.getNumTouchedNodes();
+
+        if (update % checkInterval == 0) {
+            CsrGraph current(numNodes, edges, undirected);
+            stopwatch.restart();
+            runDijkstra(current, 0, distances, prevs);
+            dijkstraMs += stopwatch.getElapsedMs();
+            numChecks++;
+
+            mismatches += countMismatches(edges, undirected, paths.getDistances(), paths.getPrevs(), distances);
+        }
+    }
+
+    std::cout << name << ": " << numNodes << " nodes, " << edges.size() << " edges, initial run "
+              << std::fixed << std::setprecision(1) << initialMs << " ms" << std::endl;
+    std::cout << std::left << std::setw(28) << "  Dijkstra from scratch" << std::right << std::setw(12)
+              << std::setprecision(1) << 1000.0 * dijkstraMs / numChecks << " us/update" << std::endl;
+    std::cout << std::left << std::setw(28) << "  dynamic repair" << std::right << std::setw(12)
+              << 1000.0 * updateMs / numUpdates << " us/update" << std::setw(12)
+              << static_cast<double>(touchedNodes) / numUpdates << " touched nodes/update   mismatches: "
+              << mismatches << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int numNodes = argc > 1 ? std::stoi(argv[1]) : 1000000;
+    int numUpdates = argc > 2 ? std::stoi(argv[2]) : 10000;
+    int batchSize = argc > 3 ? std::stoi(argv[3]) : 4;
+    int checkInterval = argc > 4 ? std::stoi(argv[4]) : 1000;
+
+    int side = static_cast<int>(std::sqrt(numNodes));
+    runUpdates("grid", side * side, generateGridGraph(side, side, 1, 100), true, numUpdates, batchSize,
+               checkInterval);
+    runUpdates("G(n, m)", numNodes, generateRandomGraph(numNodes, 4 * numNodes, 1000), false, numUpdates, batchSize,
+               checkInterval);
+
+    return 0;
+}
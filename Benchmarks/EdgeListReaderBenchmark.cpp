@@ -0,0 +1,95 @@
+// Parsing throughput of FastInputReader against the getline + istringstream
+// loop the readInput() functions used before, in MB/s.
+//
+// g++ -std=c++17 -O2 EdgeListReaderBenchmark.cpp -o edge_list_reader_benchmark
+// ./edge_list_reader_benchmark [numEdges]
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+#include "../Common/FastInputReader.h"
+#include "SyntheticGraphs.h"
+#include "../Common/Stopwatch.h"
+
+std::size_t writeEdgeList(const std::string& path, const std::vector<CsrEdge>& edges, bool dashed) {
+    std::ofstream out(path);
+    for (const CsrEdge& edge : edges) {
+        if (dashed) {
+            out << edge.from << " - " << edge.to << " - " << edge.weight << '\n';
+        } else {
+            out << edge.from << ' ' << edge.to << ' ' << edge.weight << '\n';
+        }
+    }
+    return static_cast<std::size_t>(out.tellp());
+}
+
+long long parseWithStringStreams(const std::string& path, int numEdges, bool dashed) {
+    std::ifstream in(path);
+    long long checksum{};
+
+    for (int i = 0; i < numEdges; i++) {
+        std::string line;
+        std::getline(in >> std::ws, line);
+        std::istringstream istr(line);
+
+        int from{}, to{}, weight{};
+        if (dashed) {
+            char d1, d2;
+            istr >> from >> d1 >> to >> d2 >> weight;
+        } else {
+            istr >> from >> to >> weight;
+        }
+        checksum += from + to + weight;
+    }
+
+    return checksum;
+}
+
+long long parseWithFastReader(const std::string& path, int numEdges) {
+    FastInputReader reader(path);
+    long long checksum{};
+
+    for (int i = 0; i < numEdges; i++) {
+        CsrEdge edge = reader.readEdge();
+        checksum += edge.from + edge.to + edge.weight;
+    }
+
+    return checksum;
+}
+
+void report(const std::string& name, std::size_t bytes, double elapsedMs, long long checksum) {
+    double megabytesPerSecond = bytes / (1024.0 * 1024.0) / (elapsedMs / 1000.0);
+    std::cout << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << elapsedMs << " ms" << std::setw(10) << megabytesPerSecond << " MB/s"
+              << "   checksum " << checksum << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int numEdges = argc > 1 ? std::stoi(argv[1]) : 5000000;
+    std::vector<CsrEdge> edges = generateRandomGraph(1000000, numEdges, 100000);
+
+    for (bool dashed : { false, true }) {
+        std::string path = dashed ? "edge_list_dashed.txt" : "edge_list_plain.txt";
+        std::size_t bytes = writeEdgeList(path, edges, dashed);
+
+        std::cout << (dashed ? "\"from - to - weight\"" : "\"src dest weight\"") << ", "
+                  << numEdges << " edges, " << bytes / (1024 * 1024) << " MB" << std::endl;
+
+        Stopwatch stopwatch;
+        long long checksum = parseWithStringStreams(path, numEdges, dashed);
+        report("  getline + istringstream", bytes, stopwatch.getElapsedMs(), checksum);
+
+        stopwatch.restart();
+        checksum = parseWithFastReader(path, numEdges);
+        report("  FastInputReader", bytes, stopwatch.getElapsedMs(), checksum);
+
+        std::remove(path.c_str());
+    }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+// All-pairs shortest paths on a dense random graph (about half of all V^2
+// arcs, a few negative ones, no negative cycle): the textbook triple loop
+// against blocked Floyd-Warshall with the scalar and the AVX2 tile kernel at
+// 1, 2, 4, ... maxThreads threads (the global pool is sized for maxThreads),
+// and Johnson's algorithm for comparison. Every
+// matrix is checked against the triple loop. A 3-node graph whose partial
+// sums leave the int range checks that both kernels saturate like Dijkstra.
+//
+// g++ -std=c++17 -O2 -pthread FloydWarshallBenchmark.cpp -o floyd_warshall_benchmark
+// ./floyd_warshall_benchmark [numNodes] [maxThreads]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <limits>
+
+#include "../Common/CsrGraph.h"
+#include "../Common/Dijkstra.h"
+#include "../Common/DistanceTable.h"
+#include "../Common/FloydWarshall.h"
+#include "../Common/Johnson.h"
+#include "../Common/Parallel.h"
+#include "../Common/ThreadPool.h"
+#include "../Common/Stopwatch.h"
+#include "SyntheticGraphs.h"
+
+void report(const std::string& name, double elapsedMs, int mismatches) {
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << elapsedMs << " ms   wrong distances: " << mismatches << std::endl;
+}
+
+int countMismatches(const DistanceMatrix& distances, const DistanceMatrix& expected) {
+    int mismatches{};
+    for (int row = 0; row < expected.getNumRows(); row++) {
+        for (int column = 0; column < expected.getNumColumns(); column++) {
+            if (distances.get(row, column) != expected.get(row, column)) {
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
+
+void runTripleLoop(DistanceMatrix& distances) {
+    const int INF = std::numeric_limits<int>::max();
+    int numNodes = distances.getNumRows();
+
+    for (int k = 0; k < numNodes; k++) {
+        const int* kRow = distances.getRow(k);
+        for (int i = 0; i < numNodes; i++) {
+            int* iRow = distances.getRow(i);
+            if (iRow[k] == INF) {
+                continue;
+            }
+            for (int j = 0; j < numNodes; j++) {
+                if (kRow[j] != INF && iRow[k] + kRow[j] < iRow[j]) {
+                    iRow[j] = iRow[k] + kRow[j];
+                }
+            }
+        }
+    }
+}
+
+// 0 -> 1 -> 2 costs 3e9 and wraps when added in an int, the direct arc 0 -> 2 costs 2e9
+int countOverflowMismatches(FloydWarshallKernel kernel) {
+    CsrGraph graph(3, { { 0, 1, 1500000000 }, { 1, 2, 1500000000 }, { 0, 2, 2000000000 } });
+
+    DistanceMatrix distances = buildArcDistances(graph);
+    runFloydWarshall(distances, 1, kernel);
+
+    int mismatches{};
+    std::vector<int> expected, prevs;
+    for (int row = 0; row < 3; row++) {
+        runDijkstra(graph, row, expected, prevs);
+        for (int column = 0; column < 3; column++) {
+            mismatches += distances.get(row, column) != expected[column];
+        }
+    }
+    return mismatches;
+}
+
+int main(int argc, char* argv[]) {
+    int numNodes = argc > 1 ? std::stoi(argv[1]) : 1024;
+    int maxThreads = argc > 2 ? std::stoi(argv[2]) : getDefaultNumThreads();
+
+    ThreadPool::configureGlobal(maxThreads);
+
+    // a random potential per node shifts the weights, some arcs turn negative but no cycle does
+    std::vector<CsrEdge> edges = generateRandomGraph(numNodes, numNodes * numNodes / 2, 100);
+    std::vector<int> potentials(numNodes);
+    for (int node = 0; node < numNodes; node++) {
+        potentials[node] = (node * 37) % 50;
+    }
+    for (CsrEdge& edge : edges) {
+        edge.weight += potentials[edge.from] - potentials[edge.to];
+    }
+    CsrGraph graph(numNodes, edges);
+
+    std::cout << numNodes << " nodes, " << graph.getNumArcs() << " arcs, AVX2 "
+              << (FloydWarshallDetail::cpuSupportsAvx2() ? "available" : "not available") << std::endl;
+
+    std::cout << "overflow check: scalar " << countOverflowMismatches(FloydWarshallKernel::Scalar)
+              << " wrong distances";
+    if (FloydWarshallDetail::cpuSupportsAvx2()) {
+        std::cout << ", AVX2 " << countOverflowMismatches(FloydWarshallKernel::Avx2) << " wrong distances";
+    }
+    std::cout << std::endl;
+
+    DistanceMatrix expected = buildArcDistances(graph);
+    Stopwatch stopwatch;
+    runTripleLoop(expected);
+    report("triple loop", stopwatch.getElapsedMs(), 0);
+
+    auto measure = [&](const std::string& name, FloydWarshallKernel kernel, int numThreads) {
+        DistanceMatrix distances = buildArcDistances(graph);
+        stopwatch.restart();
+        runFloydWarshall(distances, numThreads, kernel);
+        report(name + ", " + std::to_string(numThreads) + " thread(s)", stopwatch.getElapsedMs(),
+               countMismatches(distances, expected));
+    };
+
+    for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+        measure("blocked scalar", FloydWarshallKernel::Scalar, numThreads);
+        if (FloydWarshallDetail::cpuSupportsAvx2()) {
+            measure("blocked AVX2", FloydWarshallKernel::Avx2, numThreads);
+        }
+    }
+
+    DistanceMatrix johnson;
+    stopwatch.restart();
+    computeAllPairsDistances(graph, johnson);
+    report("Johnson", stopwatch.getElapsedMs(), countMismatches(johnson, expected));
+
+    return 0;
+}
@@ -0,0 +1,315 @@
+// Every algorithm of the lessons on every synthetic graph family at 10^3 to
+// 10^7 edges, on Google Benchmark. Besides the time per run each benchmark
+// reports ns_per_edge (time of one run / input edges) and peak_rss_mb (the
+// high water mark of the process while the benchmark ran, graph included),
+// so runs of two builds can be compared with benchmark's compare.py. (The
+// console reporter prints ns_per_edge with an "s" suffix, the value is ns.)
+//
+// Families: random G(n, m) with n = m / 8, square grid, power-law
+// (Barabasi-Albert, 8 edges per node), layered DAG and complete graph. The
+// DAG benchmarks orient every edge from the smaller to the larger node id,
+// which turns any family into a DAG.
+//
+// g++ -std=c++17 -O2 -pthread GraphAlgorithmsBenchmark.cpp -lbenchmark -o graph_algorithms_benchmark
+// ./graph_algorithms_benchmark [--max_edges=N] [--benchmark_filter=<regex>] [benchmark flags]
+//
+// e.g. --benchmark_filter='Dijkstra/grid' or --benchmark_filter='/1000$'
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <sys/resource.h>
+
+#include <benchmark/benchmark.h>
+
+#include "../Common/CsrGraph.h"
+#include "../Common/Dijkstra.h"
+#include "../Common/DisjointSet.h"
+#include "../Common/Kruskal.h"
+#include "../Common/Prim.h"
+#include "../Common/BellmanFord.h"
+#include "../Common/TopologicalSort.h"
+#include "../Common/DagPaths.h"
+#include "../Common/Semiring.h"
+#include "../Common/CableNetwork.h"
+#include "SyntheticGraphs.h"
+
+enum class GraphFamily {
+    Random,
+    Grid,
+    PowerLaw,
+    LayeredDag,
+    Complete
+};
+
+const std::vector<std::pair<GraphFamily, std::string>> FAMILIES = {
+    { GraphFamily::Random, "random" },
+    { GraphFamily::Grid, "grid" },
+    { GraphFamily::PowerLaw, "power_law" },
+    { GraphFamily::LayeredDag, "layered_dag" },
+    { GraphFamily::Complete, "complete" }
+};
+
+struct SyntheticGraph {
+    int numNodes{};
+    std::vector<CsrEdge> edges;
+};
+
+// a graph of the family with about numEdges edges, weights in [1, 1000]
+SyntheticGraph generateGraph(GraphFamily family, int numEdges) {
+    const int MAX_WEIGHT = 1000;
+
+    SyntheticGraph graph;
+    switch (family) {
+    case GraphFamily::Random:
+        graph.numNodes = std::max(2, numEdges / 8);
+        graph.edges = generateRandomGraph(graph.numNodes, numEdges, MAX_WEIGHT);
+        break;
+    case GraphFamily::Grid: {
+        // a side x side grid has 2 side (side - 1) edges
+        int side = std::max(2, static_cast<int>(std::sqrt(numEdges / 2.0)));
+        graph.numNodes = side * side;
+        graph.edges = generateGridGraph(side, side, 1, MAX_WEIGHT);
+        break;
+    }
+    case GraphFamily::PowerLaw:
+        graph.numNodes = std::max(9, numEdges / 8);
+        graph.edges = generatePowerLawGraph(graph.numNodes, 8, MAX_WEIGHT);
+        break;
+    case GraphFamily::LayeredDag: {
+        const int LAYER_WIDTH = 64;
+        int numLayers = std::max(2, numEdges / 8 / LAYER_WIDTH);
+        graph.numNodes = numLayers * LAYER_WIDTH;
+        graph.edges = generateLayeredDag(numLayers, LAYER_WIDTH, numEdges, 4, MAX_WEIGHT);
+        break;
+    }
+    case GraphFamily::Complete:
+        // n (n - 1) / 2 edges
+        graph.numNodes = std::max(2, static_cast<int>(std::sqrt(2.0 * numEdges)));
+        graph.edges = generateCompleteGraph(graph.numNodes, MAX_WEIGHT);
+        break;
+    }
+
+    return graph;
+}
+
+// every edge from the smaller to the larger node id - a DAG whatever the family
+std::vector<CsrEdge> orientAsDag(std::vector<CsrEdge> edges) {
+    for (CsrEdge& edge : edges) {
+        if (edge.from > edge.to) {
+            std::swap(edge.from, edge.to);
+        }
+    }
+    return edges;
+}
+
+// Peak resident set size. Writing "5" to clear_refs resets VmHWM to the
+// current RSS, so the high water mark covers only what runs after
+// resetPeakRss(). Without /proc the process-wide ru_maxrss is the fallback.
+void resetPeakRss() {
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if (clearRefs) {
+        clearRefs << "5";
+    }
+}
+
+double getPeakRssMb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return std::stod(line.substr(6)) / 1024.0;
+        }
+    }
+
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;
+}
+
+// Runs algorithm() once per benchmark iteration and sets the counters. The
+// graph has been built before, only the algorithm is timed.
+template <typename Algorithm>
+void measure(benchmark::State& state, std::size_t numEdges, Algorithm algorithm) {
+    resetPeakRss();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(algorithm());
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["edges"] = static_cast<double>(numEdges);
+    state.counters["ns_per_edge"] = benchmark::Counter(numEdges * 1e-9, benchmark::Counter::kIsIterationInvariantRate |
+                                                                         benchmark::Counter::kInvert);
+    state.counters["peak_rss_mb"] = getPeakRssMb();
+}
+
+void benchmarkDijkstra(benchmark::State& state, GraphFamily family) {
+    SyntheticGraph input = generateGraph(family, static_cast<int>(state.range(0)));
+    CsrGraph graph(input.numNodes, input.edges, true);
+
+    std::vector<int> distances, prevs;
+    measure(state, input.edges.size(), [&] {
+        return runDijkstra(graph, 0, distances, prevs);
+    });
+}
+
+void benchmarkKruskal(benchmark::State& state, GraphFamily family) {
+    SyntheticGraph input = generateGraph(family, static_cast<int>(state.range(0)));
+    const std::vector<CsrEdge>& edges = input.edges;
+
+    measure(state, edges.size(), [&] {
+        DisjointSet forest(input.numNodes);
+        long long forestWeight{};
+        runRadixSortKruskal(edges.size(), forest,
+                            [&](std::size_t i) { return toRadixKey(edges[i].weight); },
+                            [&](std::size_t i) { return std::make_pair(edges[i].from, edges[i].to); },
+                            [&](std::size_t i) { forestWeight += edges[i].weight; });
+        return forestWeight;
+    });
+}
+
+void benchmarkPrim(benchmark::State& state, GraphFamily family) {
+    SyntheticGraph input = generateGraph(family, static_cast<int>(state.range(0)));
+    CsrGraph graph(input.numNodes, input.edges, true);
+
+    measure(state, input.edges.size(), [&] {
+        PrimMstBuilder<> builder(graph);
+        return builder.findForest().size();
+    });
+}
+
+// queue Bellman-Ford on weights shifted by random potentials - negative arcs, no negative cycle
+void benchmarkBellmanFord(benchmark::State& state, GraphFamily family) {
+    SyntheticGraph input = generateGraph(family, static_cast<int>(state.range(0)));
+    CsrGraph graph(input.numNodes, shiftWeightsByPotentials(input.edges, input.numNodes, 500));
+
+    std::vector<int> distances, prevs;
+    measure(state, input.edges.size(), [&] {
+        return runBellmanFord(graph, 0, distances, prevs, BellmanFordMode::Queue).numRelaxations;
+    });
+}
+
+// topological sort and (max, +) relaxation, as in the LongestPath lesson
+void benchmarkDagLongestPath(benchmark::State& state, GraphFamily family) {
+    SyntheticGraph input = generateGraph(family, static_cast<int>(state.range(0)));
+    CsrGraph graph(input.numNodes, orientAsDag(input.edges));
+
+    std::vector<int> distances, prevs;
+    measure(state, input.edges.size(), [&] {
+        TopologicalOrder sortedNodes = sortTopologically(graph);
+        relaxDagInTopologicalOrder<MaxPlus<int>>(graph, sortedNodes, sortedNodes.order.front(), distances, prevs);
+        return distances.back();
+    });
+}
+
+// budgeted expansion from node 0 and one budget of 100 per node
+void benchmarkCableNetwork(benchmark::State& state, GraphFamily family) {
+    SyntheticGraph input = generateGraph(family, static_cast<int>(state.range(0)));
+    CsrGraph graph(input.numNodes, input.edges, true);
+
+    std::vector<bool> connected(input.numNodes, false);
+    connected[0] = true;
+    measure(state, input.edges.size(), [&] {
+        BudgetedExpansion<> expansion(graph, connected);
+        return expansion.findSpentBudget(100LL * input.numNodes);
+    });
+}
+
+// (max, *) Dijkstra over link reliabilities weight / 1000, as in the MostReliablePath lesson
+void benchmarkMostReliablePath(benchmark::State& state, GraphFamily family) {
+    SyntheticGraph input = generateGraph(family, static_cast<int>(state.range(0)));
+
+    std::vector<BasicCsrEdge<double>> probabilityEdges;
+    probabilityEdges.reserve(input.edges.size());
+    for (const CsrEdge& edge : input.edges) {
+        probabilityEdges.emplace_back(edge.from, edge.to, edge.weight / 1000.0);
+    }
+    BasicCsrGraph<double> graph(input.numNodes, probabilityEdges, true);
+
+    std::vector<double> reliabilities;
+    std::vector<int> prevs;
+    measure(state, input.edges.size(), [&] {
+        return runSemiringDijkstra<MaxTimes<double>>(graph, 0, reliabilities, prevs);
+    });
+}
+
+// queue Bellman-Ford with a negative cycle 0 -> 1 -> 2 -> 0 planted next to
+// the start node, as in the Undefined exercise: the time until it is reported
+void benchmarkUndefined(benchmark::State& state, GraphFamily family) {
+    SyntheticGraph input = generateGraph(family, static_cast<int>(state.range(0)));
+    std::vector<CsrEdge> edges = input.edges;
+    edges.emplace_back(0, 1, -1000);
+    edges.emplace_back(1, 2, -1000);
+    edges.emplace_back(2, 0, -1000);
+    CsrGraph graph(input.numNodes, edges);
+
+    std::vector<int> distances, prevs;
+    measure(state, input.edges.size(), [&] {
+        BellmanFordResult result = runBellmanFord(graph, 0, distances, prevs, BellmanFordMode::Queue);
+        if (!result.hasNegativeCycle) {
+            throw std::runtime_error("The planted negative cycle was not found");
+        }
+        return result.numRelaxations;
+    });
+}
+
+// --max_edges=N caps the sizes, it is removed from argv before benchmark sees it
+long long takeMaxEdges(int& argc, char* argv[]) {
+    const char* FLAG = "--max_edges=";
+
+    long long maxEdges = 10000000;
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], FLAG, std::strlen(FLAG)) == 0) {
+            maxEdges = std::stoll(argv[i] + std::strlen(FLAG));
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+
+    return maxEdges;
+}
+
+int main(int argc, char* argv[]) {
+    long long maxEdges = takeMaxEdges(argc, argv);
+
+    const std::vector<std::pair<std::string, std::function<void(benchmark::State&, GraphFamily)>>> algorithms = {
+        { "Dijkstra", benchmarkDijkstra },
+        { "Kruskal", benchmarkKruskal },
+        { "Prim", benchmarkPrim },
+        { "BellmanFord", benchmarkBellmanFord },
+        { "DagLongestPath", benchmarkDagLongestPath },
+        { "CableNetwork", benchmarkCableNetwork },
+        { "MostReliablePath", benchmarkMostReliablePath },
+        { "Undefined", benchmarkUndefined }
+    };
+
+    for (const auto& [algorithmName, run] : algorithms) {
+        for (const auto& [family, familyName] : FAMILIES) {
+            auto* registered = benchmark::RegisterBenchmark((algorithmName + "/" + familyName).c_str(),
+                                                            [run = run, family = family](benchmark::State& state) {
+                                                                run(state, family);
+                                                            });
+            for (long long numEdges = 1000; numEdges <= maxEdges; numEdges *= 10) {
+                registered->Arg(numEdges);
+            }
+            registered->Unit(benchmark::kMillisecond);
+        }
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+// Heap-driven Kruskal (std::priority_queue with a std::function comparator,
+// as in the exercises) against the radix-sort mode at different thread counts.
+//
+// g++ -std=c++17 -O2 -pthread KruskalSortBenchmark.cpp -o kruskal_sort_benchmark
+// ./kruskal_sort_benchmark [numNodes] [numEdges]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <queue>
+#include <functional>
+
+#include "../Common/CsrGraph.h"
+#include "../Common/DisjointSet.h"
+#include "../Common/Kruskal.h"
+#include "../Common/Parallel.h"
+#include "../Common/Stopwatch.h"
+#include "SyntheticGraphs.h"
+
+using PriorityQueue = std::priority_queue<CsrEdge, std::vector<CsrEdge>, 
+                                          std::function<bool(const CsrEdge& e1, const CsrEdge& e2)>>;
+
+long long runHeapKruskal(const std::vector<CsrEdge>& edges, int numNodes) {
+    PriorityQueue pq([](const CsrEdge& e1, const CsrEdge& e2) {
+        return e1.weight > e2.weight;
+    }, edges);
+
+    DisjointSet forest(numNodes);
+    long long forestWeight{};
+
+    while (!pq.empty()) {
+        CsrEdge minEdge = pq.top();
+        pq.pop();
+
+        if (forest.unite(minEdge.from, minEdge.to)) {
+            forestWeight += minEdge.weight;
+        }
+    }
+
+    return forestWeight;
+}
+
+long long runRadixKruskal(const std::vector<CsrEdge>& edges, int numNodes, int numThreads) {
+    DisjointSet forest(numNodes);
+    long long forestWeight{};
+
+    runRadixSortKruskal(edges.size(), forest,
+        [&edges](std::size_t i) { return toRadixKey(edges[i].weight); },
+        [&edges](std::size_t i) { return std::make_pair(edges[i].from, edges[i].to); },
+        [&edges, &forestWeight](std::size_t i) { forestWeight += edges[i].weight; },
+        numThreads);
+
+    return forestWeight;
+}
+
+void report(const std::string& name, double elapsedMs, long long forestWeight) {
+    std::cout << std::left << std::setw(30) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << elapsedMs << " ms   forest weight " << forestWeight << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int numNodes = argc > 1 ? std::stoi(argv[1]) : 1000000;
+    int numEdges = argc > 2 ? std::stoi(argv[2]) : 10000000;
+
+    std::vector<CsrEdge> edges = generateRandomGraph(numNodes, numEdges, 1000000);
+
+    std::cout << "G(n, m) with " << numNodes << " nodes and " << numEdges << " edges" << std::endl;
+
+    Stopwatch stopwatch;
+    long long weight = runHeapKruskal(edges, numNodes);
+    report("heap (std::function)", stopwatch.getElapsedMs(), weight);
+
+    for (int numThreads = 1; numThreads <= getDefaultNumThreads(); numThreads *= 2) {
+        stopwatch.restart();
+        weight = runRadixKruskal(edges, numNodes, numThreads);
+        report("radix sort, " + std::to_string(numThreads) + " thread(s)", stopwatch.getElapsedMs(), weight);
+    }
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+// Single-pair queries on a grid "road network": full Dijkstra, early exit,
+// bidirectional, A* with the straight-line heuristic and A* with ALT
+// landmarks. Reports settled nodes and latency per query; every distance is
+// checked against the full Dijkstra.
+//
+// g++ -std=c++17 -O2 PointToPointQueryBenchmark.cpp -o point_to_point_query_benchmark
+// ./point_to_point_query_benchmark [gridSide] [numQueries] [numLandmarks]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <utility>
+
+#include "../Common/CsrGraph.h"
+#include "../Common/Dijkstra.h"
+#include "../Common/PointToPointDijkstra.h"
+#include "../Common/Stopwatch.h"
+#include "SyntheticGraphs.h"
+
+template <typename Query>
+void measure(const std::string& name, const std::vector<std::pair<int, int>>& queries,
+             const std::vector<int>& expectedDistances, Query query) {
+    long long totalSettled{};
+    int mismatches{};
+
+    Stopwatch stopwatch;
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        PointToPointResult result = query(queries[i].first, queries[i].second);
+        totalSettled += result.numSettled;
+        if (result.distance != expectedDistances[i]) {
+            mismatches++;
+        }
+    }
+    double elapsedMs = stopwatch.getElapsedMs();
+
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << static_cast<double>(totalSettled) / queries.size() << " settled"
+              << std::setw(12) << 1000.0 * elapsedMs / queries.size() << " us/query"
+              << "   wrong distances: " << mismatches << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int side = argc > 1 ? std::stoi(argv[1]) : 1000;
+    int numQueries = argc > 2 ? std::stoi(argv[2]) : 100;
+    int numLandmarks = argc > 3 ? std::stoi(argv[3]) : 16;
+
+    // weights of at least 10 per unit of grid distance keep the straight-line bound admissible
+    CsrGraph graph(side * side, generateGridGraph(side, side, 10, 30), true);
+
+    std::vector<Coordinate> coordinates(graph.getNumNodes());
+    for (int node = 0; node < graph.getNumNodes(); node++) {
+        coordinates[node] = { static_cast<double>(node % side), static_cast<double>(node / side) };
+    }
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> nodeDist(0, graph.getNumNodes() - 1);
+    std::vector<std::pair<int, int>> queries(numQueries);
+    for (auto& query : queries) {
+        query = { nodeDist(rng), nodeDist(rng) };
+    }
+
+    std::cout << side << " x " << side << " grid, " << numQueries << " random queries" << std::endl;
+
+    std::vector<int> expectedDistances(numQueries);
+    std::vector<int> distances, prevs;
+    for (int i = 0; i < numQueries; i++) {
+        runDijkstra(graph, queries[i].first, distances, prevs);
+        expectedDistances[i] = distances[queries[i].second];
+    }
+
+    measure("full Dijkstra", queries, expectedDistances, [&](int start, int dest) {
+        PointToPointResult result;
+        result.numSettled = runDijkstra(graph, start, distances, prevs);
+        result.distance = distances[dest];
+        return result;
+    });
+
+    PointToPointDijkstra<> queryEngine(graph);
+
+    measure("early exit", queries, expectedDistances, [&](int start, int dest) {
+        return queryEngine.findEarlyExit(start, dest);
+    });
+
+    measure("bidirectional", queries, expectedDistances, [&](int start, int dest) {
+        return queryEngine.findBidirectional(start, dest);
+    });
+
+    EuclideanHeuristic euclidean(coordinates, 10.0);
+    measure("A*, straight line", queries, expectedDistances, [&](int start, int dest) {
+        return queryEngine.findAStar(start, dest, euclidean);
+    });
+
+    Stopwatch stopwatch;
+    LandmarkHeuristic landmarks(graph, numLandmarks);
+    std::cout << numLandmarks << " landmarks chosen in " << std::fixed << std::setprecision(1)
+              << stopwatch.getElapsedMs() << " ms" << std::endl;
+
+    measure("A*, ALT landmarks", queries, expectedDistances, [&](int start, int dest) {
+        return queryEngine.findAStar(start, dest, landmarks);
+    });
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+// Most reliable paths on a random network with fractional link
+// reliabilities: the (max, *) Dijkstra over probabilities against the
+// log-space ReliablePathFinder (min-sum over -log(p)), then Yen's top-k
+// paths. The reliabilities of both searches are checked against each other.
+//
+// g++ -std=c++17 -O2 ReliablePathBenchmark.cpp -o reliable_path_benchmark
+// ./reliable_path_benchmark [numNodes] [numEdges] [numQueries] [k]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <cmath>
+
+#include "../Common/CsrGraph.h"
+#include "../Common/Dijkstra.h"
+#include "../Common/Semiring.h"
+#include "../Common/ReliablePaths.h"
+#include "../Common/Stopwatch.h"
+#include "SyntheticGraphs.h"
+
+void report(const std::string& name, double elapsedMs, int numQueries, int mismatches) {
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << elapsedMs << " ms" << std::setw(12) << 1000.0 * elapsedMs / numQueries
+              << " us/query   mismatches: " << mismatches << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int numNodes = argc > 1 ? std::stoi(argv[1]) : 100000;
+    int numEdges = argc > 2 ? std::stoi(argv[2]) : 500000;
+    int numQueries = argc > 3 ? std::stoi(argv[3]) : 100;
+    int k = argc > 4 ? std::stoi(argv[4]) : 5;
+
+    // reliabilities in [0.9, 1) - long paths of likely links, like a real network
+    std::vector<BasicCsrEdge<double>> probabilityEdges;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> probabilityDist(0.9, 1.0);
+    for (const CsrEdge& edge : generateRandomGraph(numNodes, numEdges, 1)) {
+        probabilityEdges.emplace_back(edge.from, edge.to, probabilityDist(rng));
+    }
+
+    BasicCsrGraph<double> probabilities(numNodes, probabilityEdges, true);
+    LogCostGraph logCosts = buildLogCostGraph(numNodes, probabilityEdges, true);
+
+    std::cout << numNodes << " nodes, " << logCosts.getNumArcs() << " arcs, " << numQueries << " random queries"
+              << std::endl;
+
+    std::uniform_int_distribution<int> nodeDist(0, numNodes - 1);
+    std::vector<std::pair<int, int>> queries(numQueries);
+    for (auto& query : queries) {
+        query = { nodeDist(rng), nodeDist(rng) };
+    }
+
+    std::vector<double> expected(numQueries);
+    std::vector<double> reliabilities;
+    std::vector<int> prevs;
+    Stopwatch stopwatch;
+    for (int i = 0; i < numQueries; i++) {
+        runSemiringDijkstra<MaxTimes<double>>(probabilities, queries[i].first, reliabilities, prevs, queries[i].second);
+        expected[i] = reliabilities[queries[i].second];
+    }
+    report("(max, *) over probabilities", stopwatch.getElapsedMs(), numQueries, 0);
+
+    ReliablePathFinder<> finder(logCosts);
+    int mismatches{};
+    stopwatch.restart();
+    for (int i = 0; i < numQueries; i++) {
+        ReliablePath path = finder.findMostReliablePath(queries[i].first, queries[i].second);
+        double reliability = path.isFound() ? path.getReliability() : 0.0;
+        if (std::abs(reliability - expected[i]) > 1e-9 * std::max(1.0, expected[i])) {
+            mismatches++;
+        }
+    }
+    report("log space", stopwatch.getElapsedMs(), numQueries, mismatches);
+
+    stopwatch.restart();
+    long long numPaths{};
+    for (int i = 0; i < numQueries; i++) {
+        numPaths += finder.findMostReliablePaths(queries[i].first, queries[i].second, k).size();
+    }
+    report("log space, top " + std::to_string(k) + " (Yen)", stopwatch.getElapsedMs(), numQueries, 0);
+    std::cout << numPaths << " paths found" << std::endl;
+
+    return 0;
+}
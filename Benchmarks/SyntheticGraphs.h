@@ -0,0 +1,144 @@
+#pragma once
+
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "../Common/CsrGraph.h"
+
+// G(n, m) - numEdges directed edges with uniformly random endpoints and weights in [1, maxWeight]
+inline std::vector<CsrEdge> generateRandomGraph(int numNodes, int numEdges, int maxWeight, unsigned seed = 42) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> nodeDist(0, numNodes - 1);
+    std::uniform_int_distribution<int> weightDist(1, maxWeight);
+
+    std::vector<CsrEdge> edges;
+    edges.reserve(numEdges);
+
+    for (int i = 0; i < numEdges; i++) {
+        edges.emplace_back(nodeDist(rng), nodeDist(rng), weightDist(rng));
+    }
+
+    return edges;
+}
+
+// width x height grid, node y * width + x, an undirected edge to the right and
+// down neighbour with weight in [minWeight, maxWeight] - a crude road network
+inline std::vector<CsrEdge> generateGridGraph(int width, int height, int minWeight, int maxWeight, unsigned seed = 42) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> weightDist(minWeight, maxWeight);
+
+    std::vector<CsrEdge> edges;
+    edges.reserve(2 * static_cast<std::size_t>(width) * height);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int node = y * width + x;
+            if (x + 1 < width) {
+                edges.emplace_back(node, node + 1, weightDist(rng));
+            }
+            if (y + 1 < height) {
+                edges.emplace_back(node, node + width, weightDist(rng));
+            }
+        }
+    }
+
+    return edges;
+}
+
+// Power-law graph (Barabasi-Albert): every new node links to edgesPerNode
+// earlier nodes picked proportionally to their degree, so a few hubs collect
+// most of the edges. Edges point from the older to the newer node, so node 0
+// reaches every node. Weights in [1, maxWeight].
+inline std::vector<CsrEdge> generatePowerLawGraph(int numNodes, int edgesPerNode, int maxWeight, unsigned seed = 42) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> weightDist(1, maxWeight);
+
+    std::vector<CsrEdge> edges;
+    edges.reserve(static_cast<std::size_t>(numNodes) * edgesPerNode);
+
+    // every edge puts both of its ends here, a uniform pick is a pick by degree
+    std::vector<int> endpoints;
+    endpoints.reserve(2 * static_cast<std::size_t>(numNodes) * edgesPerNode);
+
+    int seedNodes = std::min(numNodes, edgesPerNode + 1);
+    for (int node = 1; node < seedNodes; node++) {
+        edges.emplace_back(node - 1, node, weightDist(rng));
+        endpoints.push_back(node - 1);
+        endpoints.push_back(node);
+    }
+
+    for (int node = seedNodes; node < numNodes; node++) {
+        for (int i = 0; i < edgesPerNode; i++) {
+            int target = endpoints[std::uniform_int_distribution<std::size_t>(0, endpoints.size() - 1)(rng)];
+            edges.emplace_back(target, node, weightDist(rng));
+            endpoints.push_back(target);
+        }
+        for (int i = 0; i < edgesPerNode; i++) {
+            endpoints.push_back(node);
+        }
+    }
+
+    return edges;
+}
+
+// DAG of numLayers layers with layerWidth nodes each (node = layer * layerWidth
+// + position), numEdges edges from a random node of a layer to a random node
+// of one of the next maxSkip layers. Weights in [1, maxWeight].
+inline std::vector<CsrEdge> generateLayeredDag(int numLayers, int layerWidth, int numEdges, int maxSkip, int maxWeight,
+                                               unsigned seed = 42) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> layerDist(0, numLayers - 2);
+    std::uniform_int_distribution<int> positionDist(0, layerWidth - 1);
+    std::uniform_int_distribution<int> skipDist(1, maxSkip);
+    std::uniform_int_distribution<int> weightDist(1, maxWeight);
+
+    std::vector<CsrEdge> edges;
+    edges.reserve(numEdges);
+
+    for (int i = 0; i < numEdges; i++) {
+        int layer = layerDist(rng);
+        int nextLayer = std::min(numLayers - 1, layer + skipDist(rng));
+        edges.emplace_back(layer * layerWidth + positionDist(rng), nextLayer * layerWidth + positionDist(rng),
+                           weightDist(rng));
+    }
+
+    return edges;
+}
+
+// complete graph, one edge (u, v) with u < v per node pair, weights in [1, maxWeight]
+inline std::vector<CsrEdge> generateCompleteGraph(int numNodes, int maxWeight, unsigned seed = 42) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> weightDist(1, maxWeight);
+
+    std::vector<CsrEdge> edges;
+    edges.reserve(static_cast<std::size_t>(numNodes) * (numNodes - 1) / 2);
+
+    for (int from = 0; from < numNodes; from++) {
+        for (int to = from + 1; to < numNodes; to++) {
+            edges.emplace_back(from, to, weightDist(rng));
+        }
+    }
+
+    return edges;
+}
+
+// Adds potentials[from] - potentials[to] to every weight with random
+// potentials in [0, maxPotential]: some arcs turn negative, but every cycle
+// keeps its weight, so there is no negative cycle when there was none before.
+inline std::vector<CsrEdge> shiftWeightsByPotentials(std::vector<CsrEdge> edges, int numNodes, int maxPotential,
+                                                     unsigned seed = 7) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> potentialDist(0, maxPotential);
+
+    std::vector<int> potentials(numNodes);
+    for (int& potential : potentials) {
+        potential = potentialDist(rng);
+    }
+
+    for (CsrEdge& edge : edges) {
+        edge.weight += potentials[edge.from] - potentials[edge.to];
+    }
+
+    return edges;
+}
@@ -0,0 +1,148 @@
+// Overhead of the parallel loops: a thread per chunk and call (what
+// parallelForChunks did before the ThreadPool) against parallelForChunks and
+// parallelFor on the persistent work-stealing pool, for many short calls -
+// the shape of the per-level loops of the DAG and Bellman-Ford kernels -
+// and for one long, unevenly loaded range. Every variant has to produce the
+// same sums.
+//
+// g++ -std=c++17 -O2 -pthread ThreadPoolBenchmark.cpp -o thread_pool_benchmark
+// ./thread_pool_benchmark [numCalls] [callSize] [numThreads] [--pin]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+#include "../Common/Parallel.h"
+#include "../Common/ThreadPool.h"
+#include "../Common/Stopwatch.h"
+
+// the former parallelForChunks: numThreads - 1 new threads per call
+template <typename Function>
+void spawnThreadsForChunks(std::size_t count, int numThreads, Function function) {
+    std::vector<std::thread> workers;
+    for (int chunk = 1; chunk < numThreads; chunk++) {
+        workers.emplace_back([&function, count, numThreads, chunk]() {
+            function(count * chunk / numThreads, count * (chunk + 1) / numThreads);
+        });
+    }
+    function(0, count / numThreads);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// numSteps steps of a random number generator seeded with i
+std::uint64_t work(std::size_t i, std::size_t numSteps) {
+    std::uint64_t value = i;
+    for (std::size_t step = 0; step < numSteps; step++) {
+        value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    return value;
+}
+
+void report(const std::string& name, double elapsedMs, int numCalls, std::uint64_t sum, std::uint64_t expected) {
+    std::cout << std::left << std::setw(36) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << elapsedMs << " ms" << std::setw(12) << std::setprecision(2)
+              << 1000.0 * elapsedMs / numCalls << " us/call" << (sum == expected ? "" : "   MISMATCH") << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> arguments;
+    bool pinThreads = false;
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument == "--pin") {
+            pinThreads = true;
+        } else {
+            arguments.push_back(argument);
+        }
+    }
+
+    int numCalls = arguments.size() > 0 ? std::stoi(arguments[0]) : 2000;
+    std::size_t callSize = arguments.size() > 1 ? std::stoul(arguments[1]) : 4096;
+    int numThreads = arguments.size() > 2 ? std::stoi(arguments[2]) : getDefaultNumThreads();
+
+    ThreadPool::configureGlobal(numThreads, pinThreads);
+    const ThreadPool& pool = ThreadPool::getGlobal();
+    std::cout << numThreads << " threads (" << pool.getNumWorkers() << " pool workers";
+    if (pinThreads) {
+        std::cout << ", " << pool.getNumPinnedWorkers() << " of them pinned";
+    }
+    std::cout << "), " << numCalls << " calls of " << callSize << " items" << std::endl;
+
+    std::uint64_t expected{};
+    for (int call = 0; call < numCalls; call++) {
+        for (std::size_t i = 0; i < callSize; i++) {
+            expected += work(i, i % 64);
+        }
+    }
+
+    std::atomic<std::uint64_t> sum{ 0 };
+    auto sumRange = [&sum](std::size_t begin, std::size_t end) {
+        std::uint64_t partial{};
+        for (std::size_t i = begin; i < end; i++) {
+            partial += work(i, i % 64);
+        }
+        sum += partial;
+    };
+
+    Stopwatch stopwatch;
+    for (int call = 0; call < numCalls; call++) {
+        spawnThreadsForChunks(callSize, numThreads, sumRange);
+    }
+    report("thread per chunk", stopwatch.getElapsedMs(), numCalls, sum, expected);
+
+    sum = 0;
+    stopwatch.restart();
+    for (int call = 0; call < numCalls; call++) {
+        parallelForChunks(callSize, numThreads, [&sumRange](int, std::size_t begin, std::size_t end) {
+            sumRange(begin, end);
+        });
+    }
+    report("parallelForChunks on the pool", stopwatch.getElapsedMs(), numCalls, sum, expected);
+
+    sum = 0;
+    stopwatch.restart();
+    for (int call = 0; call < numCalls; call++) {
+        parallelFor(0, callSize, 0, sumRange);
+    }
+    report("parallelFor, work stealing", stopwatch.getElapsedMs(), numCalls, sum, expected);
+
+    // one call over a range whose cost per item grows along it: equal chunks
+    // leave the first threads idle, stolen halves keep everybody busy
+    std::size_t rampSize = callSize * 64;
+    auto rampWork = [rampSize](std::size_t i) {
+        return work(i, 256 * i / rampSize);
+    };
+
+    std::uint64_t rampExpected{};
+    for (std::size_t i = 0; i < rampSize; i++) {
+        rampExpected += rampWork(i);
+    }
+
+    auto sumRamp = [&sum, &rampWork](std::size_t begin, std::size_t end) {
+        std::uint64_t partial{};
+        for (std::size_t i = begin; i < end; i++) {
+            partial += rampWork(i);
+        }
+        sum += partial;
+    };
+
+    sum = 0;
+    stopwatch.restart();
+    parallelForChunks(rampSize, numThreads, [&sumRamp](int, std::size_t begin, std::size_t end) {
+        sumRamp(begin, end);
+    });
+    report("uneven range, equal chunks", stopwatch.getElapsedMs(), 1, sum, rampExpected);
+
+    sum = 0;
+    stopwatch.restart();
+    parallelFor(0, rampSize, 0, sumRamp);
+    report("uneven range, work stealing", stopwatch.getElapsedMs(), 1, sum, rampExpected);
+
+    return 0;
+}
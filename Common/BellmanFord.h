@@ -0,0 +1,351 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+#include "CsrGraph.h"
+#include "Semiring.h"
+#include "Parallel.h"
+
+enum class BellmanFordMode {
+    Passes,   // full passes over all arcs, stops after the first pass without a change
+    Queue,    // only the arcs of nodes whose distance changed in the previous pass (SPFA)
+    Parallel  // full passes with the arcs split across threads
+};
+
+struct BellmanFordResult {
+    bool hasNegativeCycle = false;
+    std::vector<int> negativeCycle;   // nodes of one negative cycle in arc order, first node not repeated
+    int numPasses{};
+    long long numRelaxations{};
+};
+
+// Cycle in the predecessor graph, found by walking every node towards its
+// root and stamping the nodes of the current walk - O(V). A cycle of prevs
+// is always a negative cycle of the graph. Returns an empty vector when the
+// predecessor graph is a forest.
+inline std::vector<int> findPredecessorCycle(const std::vector<int>& prevs) {
+    int numNodes = static_cast<int>(prevs.size());
+    std::vector<int> walkIds(numNodes, -1);
+
+    for (int start = 0; start < numNodes; start++) {
+        int node = start;
+        while (node != -1 && walkIds[node] == -1) {
+            walkIds[node] = start;
+            node = prevs[node];
+        }
+
+        if (node != -1 && walkIds[node] == start) {
+            // node is on the cycle, collect it against the prev direction
+            std::vector<int> cycle;
+            int current = node;
+            do {
+                cycle.push_back(current);
+                current = prevs[current];
+            } while (current != node);
+
+            std::reverse(cycle.begin(), cycle.end());
+            return cycle;
+        }
+    }
+
+    return {};
+}
+
+// Canonical shortest path tree for final distances: a BFS from startNode
+// over the tight arcs (extend(distances[from], weight) == distances[to]) in
+// CSR order, every node takes the first node that reaches it. The tree
+// depends only on the graph and the distances, not on the order in which the
+// relaxations happened, so every mode yields the same prevs.
+template <typename Semiring>
+void buildShortestPathTree(const BasicCsrGraph<typename Semiring::WeightType>& graph, int startNode,
+                           const std::vector<typename Semiring::WeightType>& distances, std::vector<int>& prevs) {
+    prevs.assign(graph.getNumNodes(), -1);
+    std::vector<bool> reached(graph.getNumNodes(), false);
+    std::vector<int> queue;
+    queue.reserve(graph.getNumNodes());
+
+    reached[startNode] = true;
+    queue.push_back(startNode);
+
+    for (std::size_t head = 0; head < queue.size(); head++) {
+        int from = queue[head];
+        if (distances[from] == Semiring::zero()) {
+            continue;
+        }
+
+        for (int arc = graph.getFirstArc(from); arc < graph.getLastArc(from); arc++) {
+            int to = graph.getTarget(arc);
+            if (!reached[to] && Semiring::extend(distances[from], graph.getWeight(arc)) == distances[to]) {
+                reached[to] = true;
+                prevs[to] = from;
+                queue.push_back(to);
+            }
+        }
+    }
+}
+
+namespace BellmanFordDetail {
+
+// the bits of a 32-bit distance in the high half, prev in the low half - one
+// CAS updates both
+template <typename Weight>
+std::uint64_t packLabel(Weight distance, int prev) {
+    static_assert(sizeof(Weight) == sizeof(std::uint32_t), "a packed label holds a 32-bit distance");
+
+    std::uint32_t bits;
+    std::memcpy(&bits, &distance, sizeof(bits));
+    return (static_cast<std::uint64_t>(bits) << 32) | static_cast<std::uint32_t>(prev);
+}
+
+template <typename Weight>
+Weight unpackDistance(std::uint64_t label) {
+    std::uint32_t bits = static_cast<std::uint32_t>(label >> 32);
+    Weight distance;
+    std::memcpy(&distance, &bits, sizeof(distance));
+    return distance;
+}
+
+inline int unpackPrev(std::uint64_t label) {
+    return static_cast<int>(static_cast<std::uint32_t>(label));
+}
+
+// Full passes with the arc array split into numThreads contiguous ranges.
+// Every node label is one 64-bit atomic holding (distance, prev), improved by
+// a CAS loop only on a strict improvement, so a prev always belongs to the
+// distance stored with it and the predecessor graph keeps the sequential
+// invariant (a cycle in it is a negative cycle). A pass without any change in
+// any chunk ends the search.
+template <typename Semiring>
+BellmanFordResult runParallelPasses(const BasicCsrGraph<typename Semiring::WeightType>& graph, int startNode,
+                                    std::vector<typename Semiring::WeightType>& distances, std::vector<int>& prevs,
+                                    int numThreads) {
+    using Weight = typename Semiring::WeightType;
+
+    int numNodes = graph.getNumNodes();
+    numThreads = std::max(1, numThreads);
+
+    auto labels = std::make_unique<std::atomic<std::uint64_t>[]>(numNodes);
+    for (int node = 0; node < numNodes; node++) {
+        labels[node].store(packLabel(Semiring::zero(), -1), std::memory_order_relaxed);
+    }
+    labels[startNode].store(packLabel(Semiring::one(), -1), std::memory_order_relaxed);
+
+    std::vector<char> chunkChanged(numThreads);
+    std::vector<long long> chunkRelaxations(numThreads);
+
+    BellmanFordResult result;
+
+    auto copyLabels = [&]() {
+        for (int node = 0; node < numNodes; node++) {
+            std::uint64_t label = labels[node].load(std::memory_order_relaxed);
+            distances[node] = unpackDistance<Weight>(label);
+            prevs[node] = unpackPrev(label);
+        }
+    };
+
+    distances.assign(numNodes, Semiring::zero());
+    prevs.assign(numNodes, -1);
+
+    while (true) {
+        result.numPasses++;
+        std::fill(chunkChanged.begin(), chunkChanged.end(), 0);
+        std::fill(chunkRelaxations.begin(), chunkRelaxations.end(), 0);
+
+        parallelForChunks(graph.getNumArcs(), numThreads, [&](int chunk, std::size_t begin, std::size_t end) {
+            if (begin == end) {
+                return;
+            }
+
+            int from = graph.findSource(static_cast<int>(begin));
+            for (int arc = static_cast<int>(begin); arc < static_cast<int>(end); arc++) {
+                while (arc >= graph.getLastArc(from)) {
+                    from++;
+                }
+
+                Weight fromDistance = unpackDistance<Weight>(labels[from].load(std::memory_order_relaxed));
+                if (fromDistance == Semiring::zero()) {
+                    continue;
+                }
+
+                int to = graph.getTarget(arc);
+                Weight newDistance = Semiring::extend(fromDistance, graph.getWeight(arc));
+                std::uint64_t newLabel = packLabel(newDistance, from);
+
+                // atomic "best of" on the distance half
+                std::uint64_t current = labels[to].load(std::memory_order_relaxed);
+                while (Semiring::isBetter(newDistance, unpackDistance<Weight>(current))) {
+                    if (labels[to].compare_exchange_weak(current, newLabel, std::memory_order_relaxed)) {
+                        chunkChanged[chunk] = 1;
+                        chunkRelaxations[chunk]++;
+                        break;
+                    }
+                }
+            }
+        });
+
+        for (const long long relaxations : chunkRelaxations) {
+            result.numRelaxations += relaxations;
+        }
+
+        if (std::find(chunkChanged.begin(), chunkChanged.end(), 1) == chunkChanged.end()) {
+            copyLabels();
+            return result;
+        }
+
+        // the O(V) cycle check is cheap next to the O(E) pass
+        copyLabels();
+        result.negativeCycle = findPredecessorCycle(prevs);
+        if (!result.negativeCycle.empty()) {
+            result.hasNegativeCycle = true;
+            return result;
+        }
+    }
+}
+
+} // namespace BellmanFordDetail
+
+// Single-source shortest paths with negative arc weights for a path
+// semiring (Semiring.h), MinPlus in runBellmanFord below. distances and prevs
+// are (re)initialised here; unreachable nodes keep Semiring::zero() and
+// prev -1.
+//
+// Passes mode is the textbook algorithm with early termination: it stops
+// after the first pass that changes nothing, so graphs whose shortest paths
+// have few arcs converge in a few passes instead of V - 1.
+//
+// Queue mode keeps a FIFO frontier of the nodes whose distance changed in
+// the previous pass and only relaxes their arcs. Pass k of either mode finds
+// every shortest path of at most k arcs, so a change in pass V proves a
+// negative cycle. In addition the predecessor graph is checked for a cycle
+// every V relaxations (walk-to-root, O(V), amortised O(1) per relaxation),
+// which usually finds a cycle long before pass V.
+//
+// Parallel mode relaxes every arc in each pass, split across numThreads
+// threads, and looks for a predecessor cycle after every pass. Its labels
+// pack distance and prev into one 64-bit atomic, so it needs a 32-bit Weight
+// and throws for any other.
+//
+// A negative cycle (for MaxPlus: a positive one) stops the search and is
+// reported in the result instead of terminating the process; distances are
+// not final in that case. Otherwise the distances are the same in every mode
+// and prevs is the canonical tree of buildShortestPathTree, so the result
+// does not depend on the mode or the number of threads.
+template <typename Semiring>
+BellmanFordResult runSemiringBellmanFord(const BasicCsrGraph<typename Semiring::WeightType>& graph, int startNode,
+                                         std::vector<typename Semiring::WeightType>& distances,
+                                         std::vector<int>& prevs, BellmanFordMode mode = BellmanFordMode::Queue,
+                                         int numThreads = getDefaultNumThreads()) {
+    using Weight = typename Semiring::WeightType;
+
+    if (mode == BellmanFordMode::Parallel) {
+        if constexpr (sizeof(Weight) == sizeof(std::uint32_t)) {
+            BellmanFordResult result = BellmanFordDetail::runParallelPasses<Semiring>(graph, startNode, distances,
+                                                                                      prevs, numThreads);
+            if (!result.hasNegativeCycle) {
+                buildShortestPathTree<Semiring>(graph, startNode, distances, prevs);
+            }
+            return result;
+        } else {
+            throw std::runtime_error("Parallel Bellman-Ford needs a 32-bit weight type");
+        }
+    }
+
+    int numNodes = graph.getNumNodes();
+
+    distances.assign(numNodes, Semiring::zero());
+    prevs.assign(numNodes, -1);
+    distances[startNode] = Semiring::one();
+
+    BellmanFordResult result;
+
+    auto reportCycle = [&result, &prevs]() {
+        result.negativeCycle = findPredecessorCycle(prevs);
+        result.hasNegativeCycle = !result.negativeCycle.empty();
+        return result.hasNegativeCycle;
+    };
+
+    long long nextCycleCheck = numNodes;
+
+    std::vector<int> frontier, nextFrontier;
+    std::vector<bool> inNextFrontier(numNodes, false);
+    frontier.push_back(startNode);
+
+    while (true) {
+        bool changed = false;
+        result.numPasses++;
+
+        auto relaxArcsOf = [&](int from) {
+            if (distances[from] == Semiring::zero()) {
+                return;
+            }
+
+            for (int arc = graph.getFirstArc(from); arc < graph.getLastArc(from); arc++) {
+                int to = graph.getTarget(arc);
+                Weight newDistance = Semiring::extend(distances[from], graph.getWeight(arc));
+
+                // relaxation step
+                if (Semiring::isBetter(newDistance, distances[to])) {
+                    distances[to] = newDistance;
+                    prevs[to] = from;
+                    changed = true;
+                    result.numRelaxations++;
+
+                    if (mode == BellmanFordMode::Queue && !inNextFrontier[to]) {
+                        inNextFrontier[to] = true;
+                        nextFrontier.push_back(to);
+                    }
+                }
+            }
+        };
+
+        if (mode == BellmanFordMode::Passes) {
+            for (int from = 0; from < numNodes; from++) {
+                relaxArcsOf(from);
+            }
+        } else {
+            for (const int from : frontier) {
+                relaxArcsOf(from);
+            }
+        }
+
+        if (!changed) {
+            // saturated labels stop changing, a cycle that pushed them to the limit is still in the prevs
+            if (reportCycle()) {
+                return result;
+            }
+            buildShortestPathTree<Semiring>(graph, startNode, distances, prevs);
+            return result;
+        }
+
+        // walk-to-root check of the predecessor graph, every V relaxations and every pass from pass V on
+        if ((result.numRelaxations >= nextCycleCheck || result.numPasses >= numNodes) && reportCycle()) {
+            return result;
+        }
+        if (result.numRelaxations >= nextCycleCheck) {
+            nextCycleCheck = result.numRelaxations + numNodes;
+        }
+
+        if (mode == BellmanFordMode::Queue) {
+            frontier.swap(nextFrontier);
+            nextFrontier.clear();
+            for (const int node : frontier) {
+                inNextFrontier[node] = false;
+            }
+        }
+    }
+}
+
+// shortest paths with negative weights of any type, unreachable nodes keep
+// the largest Weight (+infinity for floating point)
+template <typename Weight>
+BellmanFordResult runBellmanFord(const BasicCsrGraph<Weight>& graph, int startNode, std::vector<Weight>& distances,
+                                 std::vector<int>& prevs, BellmanFordMode mode = BellmanFordMode::Queue,
+                                 int numThreads = getDefaultNumThreads()) {
+    return runSemiringBellmanFord<MinPlus<Weight>>(graph, startNode, distances, prevs, mode, numThreads);
+}
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <limits>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define GRAPH_HAS_MMAP 1
+#endif
+
+#include "CsrGraph.h"
+#include "FastInputReader.h"
+
+// Binary graph file (.csrg), little endian:
+//
+//   BinaryGraphHeader (64 bytes)
+//   int32 offsets[numNodes + 1]
+//   int32 targets[numArcs], weights[numArcs], edgeIds[numArcs]
+//   if FLAG_REVERSE: the same four arrays for the reverse CSR
+//
+// The arrays are exactly the CsrGraph layout, so loading maps the file and
+// points the graph at it - nothing is parsed or copied and start-up time does
+// not depend on the graph size.
+
+constexpr char BINARY_GRAPH_MAGIC[8] = { 'C', 'S', 'R', 'G', 'R', 'A', 'P', 'H' };
+constexpr std::uint32_t BINARY_GRAPH_VERSION = 1;
+
+constexpr std::uint32_t BINARY_GRAPH_FLAG_UNDIRECTED = 1u << 0;
+constexpr std::uint32_t BINARY_GRAPH_FLAG_REVERSE = 1u << 1;
+
+struct BinaryGraphHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::uint64_t numNodes;
+    std::uint64_t numArcs;
+    std::uint64_t numEdges;
+    std::uint64_t reserved[3];
+};
+
+static_assert(sizeof(BinaryGraphHeader) == 64, "the header is part of the file format");
+
+// read-only view of a whole file, memory-mapped where the platform allows it
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef GRAPH_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Can not open " + path);
+        }
+
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Can not stat " + path);
+        }
+
+        _size = static_cast<std::size_t>(info.st_size);
+        if (_size > 0) {
+            void* mapping = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Can not map " + path);
+            }
+            _data = static_cast<const char*>(mapping);
+        }
+        ::close(fd);
+#else
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Can not open " + path);
+        }
+        _copy.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        _size = _copy.size();
+        _data = _copy.data();
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#ifdef GRAPH_HAS_MMAP
+        if (_data != nullptr) {
+            ::munmap(const_cast<char*>(_data), _size);
+        }
+#endif
+    }
+
+    const char* getData() const { return _data; }
+    std::size_t getSize() const { return _size; }
+
+private:
+    const char* _data = nullptr;
+    std::size_t _size{};
+#ifndef GRAPH_HAS_MMAP
+    std::vector<char> _copy;
+#endif
+};
+
+inline bool isBinaryGraphFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(BINARY_GRAPH_MAGIC)]{};
+    in.read(magic, sizeof(magic));
+    return in && std::memcmp(magic, BINARY_GRAPH_MAGIC, sizeof(magic)) == 0;
+}
+
+inline void saveBinaryGraph(const CsrGraph& graph, const std::string& path) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("Can not create " + path);
+    }
+
+    BinaryGraphHeader header{};
+    std::memcpy(header.magic, BINARY_GRAPH_MAGIC, sizeof(header.magic));
+    header.version = BINARY_GRAPH_VERSION;
+    header.flags = (graph.isUndirected() ? BINARY_GRAPH_FLAG_UNDIRECTED : 0) |
+                   (graph.hasReverse() ? BINARY_GRAPH_FLAG_REVERSE : 0);
+    header.numNodes = graph.getNumNodes();
+    header.numArcs = graph.getNumArcs();
+    header.numEdges = graph.getNumEdges();
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    const CsrArrays& arrays = graph.getArrays();
+    auto writeArray = [&out](const int* data, std::size_t count) {
+        out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(int)));
+    };
+
+    std::size_t numNodes = graph.getNumNodes(), numArcs = graph.getNumArcs();
+
+    writeArray(arrays.offsets, numNodes + 1);
+    writeArray(arrays.targets, numArcs);
+    writeArray(arrays.weights, numArcs);
+    writeArray(arrays.edgeIds, numArcs);
+
+    if (graph.hasReverse()) {
+        writeArray(arrays.revOffsets, numNodes + 1);
+        writeArray(arrays.revSources, numArcs);
+        writeArray(arrays.revWeights, numArcs);
+        writeArray(arrays.revEdgeIds, numArcs);
+    }
+
+    if (!out) {
+        throw std::runtime_error("Can not write " + path);
+    }
+}
+
+// Maps a binary graph file. The header is checked against the file size and
+// the first and last offsets against the arc count, which is O(1); the arrays
+// themselves are trusted - validateBinaryGraph checks them in O(V + E).
+inline CsrGraph loadBinaryGraph(const std::string& path) {
+    auto file = std::make_shared<MappedFile>(path);
+
+    if (file->getSize() < sizeof(BinaryGraphHeader)) {
+        throw std::runtime_error(path + " is not a binary graph file");
+    }
+
+    BinaryGraphHeader header{};
+    std::memcpy(&header, file->getData(), sizeof(header));
+
+    if (std::memcmp(header.magic, BINARY_GRAPH_MAGIC, sizeof(header.magic)) != 0) {
+        throw std::runtime_error(path + " is not a binary graph file");
+    }
+    if (header.version != BINARY_GRAPH_VERSION) {
+        throw std::runtime_error(path + " has unsupported format version " + std::to_string(header.version));
+    }
+
+    // bounded counts also keep the size computation below from wrapping around
+    const std::uint64_t maxCount = std::numeric_limits<int>::max() - 1;
+    if (header.numNodes > maxCount || header.numArcs > maxCount || header.numEdges > maxCount) {
+        throw std::runtime_error(path + " has a node, arc or edge count out of range");
+    }
+
+    bool withReverse = (header.flags & BINARY_GRAPH_FLAG_REVERSE) != 0;
+    std::uint64_t numInts = (header.numNodes + 1) + 3 * header.numArcs;
+    if (withReverse) {
+        numInts *= 2;
+    }
+    if (file->getSize() < sizeof(header) + numInts * sizeof(int)) {
+        throw std::runtime_error(path + " is truncated");
+    }
+
+    const int* data = reinterpret_cast<const int*>(file->getData() + sizeof(header));
+    int numNodes = static_cast<int>(header.numNodes);
+    int numArcs = static_cast<int>(header.numArcs);
+
+    CsrArrays arrays;
+    arrays.offsets = data;
+    arrays.targets = arrays.offsets + (numNodes + 1);
+    arrays.weights = arrays.targets + numArcs;
+    arrays.edgeIds = arrays.weights + numArcs;
+
+    if (withReverse) {
+        arrays.revOffsets = arrays.edgeIds + numArcs;
+        arrays.revSources = arrays.revOffsets + (numNodes + 1);
+        arrays.revWeights = arrays.revSources + numArcs;
+        arrays.revEdgeIds = arrays.revWeights + numArcs;
+    }
+
+    if (arrays.offsets[0] != 0 || arrays.offsets[numNodes] != numArcs ||
+        (withReverse && (arrays.revOffsets[0] != 0 || arrays.revOffsets[numNodes] != numArcs))) {
+        throw std::runtime_error(path + " has offsets that do not match its arc count");
+    }
+
+    return CsrGraph::fromArrays(numNodes, numArcs, static_cast<int>(header.numEdges),
+                                (header.flags & BINARY_GRAPH_FLAG_UNDIRECTED) != 0, arrays, std::move(file));
+}
+
+// Every arc range of a mapped graph is in bounds and every target, source and
+// edge id is in range, so the algorithms can index with them - throws
+// otherwise. One pass over the arrays.
+inline void validateBinaryGraph(const CsrGraph& graph, const std::string& path) {
+    int numNodes = graph.getNumNodes();
+    int numEdges = graph.getNumEdges();
+
+    auto fail = [&path](const std::string& what) {
+        throw std::runtime_error(path + " is corrupt: " + what);
+    };
+
+    for (int node = 0; node < numNodes; node++) {
+        if (graph.getFirstArc(node) > graph.getLastArc(node)) {
+            fail("offsets of node " + std::to_string(node) + " decrease");
+        }
+        for (int arc = graph.getFirstArc(node); arc < graph.getLastArc(node); arc++) {
+            if (graph.getTarget(arc) < 0 || graph.getTarget(arc) >= numNodes) {
+                fail("arc " + std::to_string(arc) + " has target " + std::to_string(graph.getTarget(arc)));
+            }
+            if (graph.getEdgeId(arc) < 0 || graph.getEdgeId(arc) >= numEdges) {
+                fail("arc " + std::to_string(arc) + " has edge id " + std::to_string(graph.getEdgeId(arc)));
+            }
+        }
+    }
+
+    if (!graph.hasReverse()) {
+        return;
+    }
+
+    for (int node = 0; node < numNodes; node++) {
+        if (graph.getFirstInArc(node) > graph.getLastInArc(node)) {
+            fail("reverse offsets of node " + std::to_string(node) + " decrease");
+        }
+        for (int inArc = graph.getFirstInArc(node); inArc < graph.getLastInArc(node); inArc++) {
+            if (graph.getInSource(inArc) < 0 || graph.getInSource(inArc) >= numNodes) {
+                fail("reverse arc " + std::to_string(inArc) + " has source " + std::to_string(graph.getInSource(inArc)));
+            }
+            if (graph.getInEdgeId(inArc) < 0 || graph.getInEdgeId(inArc) >= numEdges) {
+                fail("reverse arc " + std::to_string(inArc) + " has edge id " +
+                     std::to_string(graph.getInEdgeId(inArc)));
+            }
+        }
+    }
+}
+
+// Binary graph files are mapped, anything else is read as the plain text
+// format of the readInput() functions: "numNodes numEdges" followed by one
+// "src dest weight" line per edge. Text node ids may start from 1, so the
+// graph gets max(numNodes, largest id + 1) nodes.
+//
+// A binary graph is validated (validateBinaryGraph) once it is mapped. One
+// that lacks the requested undirected arcs or reverse CSR is rebuilt in
+// memory, every other binary graph is used straight from the mapping.
+inline CsrGraph loadGraph(const std::string& path, bool undirected = false, bool withReverse = false) {
+    if (isBinaryGraphFile(path)) {
+        CsrGraph graph = loadBinaryGraph(path);
+        validateBinaryGraph(graph, path);
+        if ((undirected && !graph.isUndirected()) || (withReverse && !graph.hasReverse())) {
+            graph = CsrGraph(graph.getNumNodes(), graph.toEdgeList(), undirected || graph.isUndirected(), withReverse);
+        }
+        return graph;
+    }
+
+    FastInputReader reader(path);
+
+    int numNodes = reader.readInt();
+    int numEdges = reader.readInt();
+
+    std::vector<CsrEdge> edges = reader.readEdges(numEdges);
+    for (const CsrEdge& edge : edges) {
+        numNodes = std::max(numNodes, std::max(edge.from, edge.to) + 1);
+    }
+
+    return CsrGraph(numNodes, edges, undirected, withReverse);
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#include "ConcurrentDisjointSet.h"
+#include "Parallel.h"
+
+// Parallel Boruvka minimum spanning forest over the edge indices [0, numEdges).
+// getEnds(i) returns the (source, dest) pair of edge i and precedes(i, j)
+// orders the edges (cheaper first), ties are broken by the smaller index so
+// the order is total and the forest is unique.
+//
+// Every round
+//   1. all live edges are scanned in parallel and each component keeps its
+//      cheapest outgoing edge in an atomic slot (CAS-min by the edge order),
+//   2. the chosen edges are united in parallel through a concurrent
+//      union-find - an edge chosen by both of its components is accepted by
+//      whichever thread links it first,
+//   3. edges inside one component are dropped from the live list.
+// The number of components at least halves per round, so there are
+// O(log V) rounds of O(E / threads) work each.
+//
+// Returns the forest edge indices sorted by the same total order, i.e. the
+// order in which Kruskal would accept them.
+template <typename GetEnds, typename Precedes>
+std::vector<std::uint32_t> findMSForestUsingBoruvka(std::size_t numEdges, int numNodes, GetEnds getEnds,
+                                                    Precedes precedes, int numThreads = getDefaultNumThreads()) {
+    constexpr std::uint32_t NO_EDGE = UINT32_MAX;
+
+    numThreads = std::max(1, numThreads);
+
+    auto isBefore = [&precedes](std::uint32_t first, std::uint32_t second) {
+        if (precedes(first, second)) {
+            return true;
+        }
+        return !precedes(second, first) && first < second;
+    };
+
+    ConcurrentDisjointSet components(numNodes);
+    auto cheapestEdges = std::make_unique<std::atomic<std::uint32_t>[]>(numNodes);
+
+    std::vector<std::uint32_t> liveEdges(numEdges);
+    for (std::size_t i = 0; i < numEdges; i++) {
+        liveEdges[i] = static_cast<std::uint32_t>(i);
+    }
+
+    std::vector<std::uint32_t> forestEdges;
+    std::vector<std::vector<std::uint32_t>> chunkEdges(numThreads);
+
+    auto clearChunks = [](std::vector<std::vector<std::uint32_t>>& chunks) {
+        for (std::vector<std::uint32_t>& chunk : chunks) {
+            chunk.clear();
+        }
+    };
+
+    auto offerEdge = [&](int component, std::uint32_t edge) {
+        std::uint32_t current = cheapestEdges[component].load(std::memory_order_relaxed);
+        while ((current == NO_EDGE || isBefore(edge, current)) &&
+               !cheapestEdges[component].compare_exchange_weak(current, edge, std::memory_order_relaxed)) {
+        }
+    };
+
+    while (!liveEdges.empty()) {
+        parallelForChunks(numNodes, numThreads, [&](int, std::size_t begin, std::size_t end) {
+            for (std::size_t node = begin; node < end; node++) {
+                cheapestEdges[node].store(NO_EDGE, std::memory_order_relaxed);
+            }
+        });
+
+        // 1. cheapest outgoing edge of every component, self-loops of components are dropped
+        clearChunks(chunkEdges);
+        parallelForChunks(liveEdges.size(), numThreads, [&](int chunk, std::size_t begin, std::size_t end) {
+            std::vector<std::uint32_t>& kept = chunkEdges[chunk];
+
+            for (std::size_t i = begin; i < end; i++) {
+                std::uint32_t edge = liveEdges[i];
+                auto [source, dest] = getEnds(edge);
+
+                int sourceRoot = components.findRoot(source);
+                int destRoot = components.findRoot(dest);
+
+                if (sourceRoot != destRoot) {
+                    offerEdge(sourceRoot, edge);
+                    offerEdge(destRoot, edge);
+                    kept.push_back(edge);
+                }
+            }
+        });
+
+        liveEdges.clear();
+        for (const std::vector<std::uint32_t>& kept : chunkEdges) {
+            liveEdges.insert(liveEdges.end(), kept.begin(), kept.end());
+        }
+
+        if (liveEdges.empty()) {
+            break;
+        }
+
+        // 2. contract - each chosen edge is accepted exactly once
+        clearChunks(chunkEdges);
+        parallelForChunks(numNodes, numThreads, [&](int chunk, std::size_t begin, std::size_t end) {
+            std::vector<std::uint32_t>& accepted = chunkEdges[chunk];
+
+            for (std::size_t node = begin; node < end; node++) {
+                std::uint32_t edge = cheapestEdges[node].load(std::memory_order_relaxed);
+                if (edge == NO_EDGE) {
+                    continue;
+                }
+
+                auto [source, dest] = getEnds(edge);
+                if (components.unite(source, dest)) {
+                    accepted.push_back(edge);
+                }
+            }
+        });
+
+        for (const std::vector<std::uint32_t>& accepted : chunkEdges) {
+            forestEdges.insert(forestEdges.end(), accepted.begin(), accepted.end());
+        }
+    }
+
+    std::sort(forestEdges.begin(), forestEdges.end(), isBefore);
+
+    return forestEdges;
+}
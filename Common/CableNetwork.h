@@ -0,0 +1,107 @@
+#pragma once
+
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+
+#include "CsrGraph.h"
+#include "IndexedDaryHeap.h"
+
+// Budgeted expansion of a cable network (CableNetwork). The nodes marked
+// connected are already on the network; the expansion repeatedly lays the
+// cheapest cable from a connected node to an unconnected one - Prim's
+// algorithm with every pre-connected node as a root. The frontier heap holds
+// each unconnected node once, keyed by its cheapest cable into the network,
+// and a node's cables are only looked at when it joins, so every cable is
+// considered at most twice (once from each end) and none is lost because
+// neither end was connected yet when it came up.
+//
+// The expansion does not depend on the budget: a budget only decides how long
+// a prefix of it is affordable. The order is computed once with the prefix
+// costs, after that every budget is a binary search - O(E log V) once, then
+// O(log V) per query. The first cable that does not fit ends the expansion,
+// and the budget has to stay positive: with budget B the first k cables are
+// laid for the largest k whose cost is < B.
+template <int Arity = 4>
+class BudgetedExpansion {
+public:
+    BudgetedExpansion(const CsrGraph& graph, const std::vector<bool>& connected) :
+        _graph(graph), _prefixCosts(1, 0) {
+        if (!graph.isUndirected()) {
+            throw std::runtime_error("The cable network must be an undirected graph");
+        }
+
+        int numNodes = graph.getNumNodes();
+        std::vector<bool> joined(connected.begin(), connected.end());
+        joined.resize(numNodes, false);
+
+        IndexedDaryHeap<int, Arity> frontier(numNodes);
+        std::vector<int> bestArcs(numNodes, -1);
+
+        for (int node = 0; node < numNodes; node++) {
+            if (joined[node]) {
+                addCables(node, joined, frontier, bestArcs);
+            }
+        }
+
+        while (!frontier.empty()) {
+            int node = frontier.pop();
+            joined[node] = true;
+
+            _arcs.push_back(bestArcs[node]);
+            _prefixCosts.push_back(_prefixCosts.back() + graph.getWeight(bestArcs[node]));
+
+            addCables(node, joined, frontier, bestArcs);
+        }
+    }
+
+    // number of cables of the full expansion (every node reachable from the network)
+    int getNumCables() const { return static_cast<int>(_arcs.size()); }
+
+    // arcs of the laid cables in expansion order, the new node is the arc target
+    const std::vector<int>& getArcs() const { return _arcs; }
+
+    // cost of the first numCables cables
+    long long getCost(int numCables) const { return _prefixCosts[numCables]; }
+
+    // number of cables laid with the budget
+    int findNumCables(long long budget) const {
+        auto end = std::lower_bound(_prefixCosts.begin(), _prefixCosts.end(), budget);
+        return std::max(0, static_cast<int>(end - _prefixCosts.begin()) - 1);
+    }
+
+    // part of the budget spent on cables
+    long long findSpentBudget(long long budget) const { return _prefixCosts[findNumCables(budget)]; }
+
+    // connected before the expansion or joined within the budget
+    std::vector<bool> findConnectedNodes(const std::vector<bool>& connected, long long budget) const {
+        std::vector<bool> result(connected.begin(), connected.end());
+        result.resize(_graph.getNumNodes(), false);
+
+        int numCables = findNumCables(budget);
+        for (int i = 0; i < numCables; i++) {
+            result[_graph.getTarget(_arcs[i])] = true;
+        }
+
+        return result;
+    }
+
+private:
+    void addCables(int node, const std::vector<bool>& joined, IndexedDaryHeap<int, Arity>& frontier,
+                   std::vector<int>& bestArcs) const {
+        for (int arc = _graph.getFirstArc(node); arc < _graph.getLastArc(node); arc++) {
+            if (_graph.getWeight(arc) < 0) {
+                throw std::runtime_error("Cable costs must not be negative");
+            }
+
+            int neighbour = _graph.getTarget(arc);
+            if (!joined[neighbour] && frontier.pushOrDecrease(neighbour, _graph.getWeight(arc))) {
+                bestArcs[neighbour] = arc;
+            }
+        }
+    }
+
+    const CsrGraph& _graph;
+    std::vector<int> _arcs;
+    std::vector<long long> _prefixCosts;   // _prefixCosts[k] = cost of the first k cables, ascending
+};
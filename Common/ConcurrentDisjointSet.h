@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <utility>
+
+// Lock-free union-find for phases where many threads unite at once. A root
+// is only ever linked below a root with a smaller id (by CAS on its parent
+// slot), so no cycles can form and a failed CAS simply retries with the new
+// roots. findRoot halves paths with best-effort CAS - a lost race only means
+// a shorter path was already written by another thread.
+class ConcurrentDisjointSet {
+public:
+    explicit ConcurrentDisjointSet(int numNodes) :
+        _parents(std::make_unique<std::atomic<std::uint32_t>[]>(numNodes)), _numNodes(numNodes) {
+        for (int node = 0; node < numNodes; node++) {
+            _parents[node].store(static_cast<std::uint32_t>(node), std::memory_order_relaxed);
+        }
+    }
+
+    int findRoot(int node) {
+        std::uint32_t current = static_cast<std::uint32_t>(node);
+        while (true) {
+            std::uint32_t parent = _parents[current].load(std::memory_order_acquire);
+            if (parent == current) {
+                return static_cast<int>(current);
+            }
+
+            std::uint32_t grandParent = _parents[parent].load(std::memory_order_acquire);
+            if (parent != grandParent) {
+                _parents[current].compare_exchange_weak(parent, grandParent, std::memory_order_acq_rel);
+            }
+            current = grandParent;
+        }
+    }
+
+    // false when both nodes already are in the same set
+    bool unite(int first, int second) {
+        while (true) {
+            std::uint32_t firstRoot = static_cast<std::uint32_t>(findRoot(first));
+            std::uint32_t secondRoot = static_cast<std::uint32_t>(findRoot(second));
+
+            if (firstRoot == secondRoot) {
+                return false;
+            }
+
+            if (firstRoot > secondRoot) {
+                std::swap(firstRoot, secondRoot);
+            }
+
+            std::uint32_t expected = secondRoot;
+            if (_parents[secondRoot].compare_exchange_strong(expected, firstRoot, std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+    }
+
+    int getNumNodes() const { return _numNodes; }
+
+private:
+    std::unique_ptr<std::atomic<std::uint32_t>[]> _parents;
+    int _numNodes{};
+};
@@ -0,0 +1,660 @@
+#pragma once
+
+#include <vector>
+#include <limits>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+
+#include "CsrGraph.h"
+#include "IndexedDaryHeap.h"
+#include "BinaryGraphFormat.h"
+#include "PointToPointDijkstra.h"
+#include "Semiring.h"
+
+// Contraction hierarchy of a graph with non-negative weights.
+//
+// Every node gets a rank (its contraction order). The arcs of the hierarchy
+// are the input arcs plus the shortcuts added during contraction and are kept
+// in two CSR graphs that both only lead "up" in rank:
+//   upward     u -> w for every arc u -> w with rank[w] > rank[u]
+//   downward   u -> w for every arc w -> u with rank[w] > rank[u], i.e. the
+//              arcs into u from above, stored at u and reversed
+// A shortest path always has a form up ... peak ... down, so a query only
+// needs a forward search over upward and a backward search over downward.
+//
+// A shortcut replaces the path from -> middle -> to through a lower ranked
+// middle node; original arcs have middle -1. Both arcs of a shortcut are
+// stored at the middle node (from -> middle in its downward list, middle -> to
+// in its upward list), which is what path unpacking follows.
+class ContractionHierarchy {
+public:
+    ContractionHierarchy() = default;
+
+    // wraps arrays owned by storage (built in memory or a mapped hierarchy file)
+    static ContractionHierarchy fromParts(int numNodes, int numShortcuts, CsrGraph upward, CsrGraph downward,
+                                          const int* ranks, const int* upMiddles, const int* downMiddles,
+                                          std::shared_ptr<const void> storage) {
+        ContractionHierarchy hierarchy;
+        hierarchy._numNodes = numNodes;
+        hierarchy._numShortcuts = numShortcuts;
+        hierarchy._upward = std::move(upward);
+        hierarchy._downward = std::move(downward);
+        hierarchy._ranks = ranks;
+        hierarchy._upMiddles = upMiddles;
+        hierarchy._downMiddles = downMiddles;
+        hierarchy._storage = std::move(storage);
+        return hierarchy;
+    }
+
+    int getNumNodes() const { return _numNodes; }
+    int getNumShortcuts() const { return _numShortcuts; }
+    int getRank(int node) const { return _ranks[node]; }
+
+    const CsrGraph& getUpward() const { return _upward; }
+    const CsrGraph& getDownward() const { return _downward; }
+    int getUpMiddle(int arc) const { return _upMiddles[arc]; }
+    int getDownMiddle(int arc) const { return _downMiddles[arc]; }
+
+    // Appends the nodes of the original path behind the hierarchy arc
+    // from -> to (from itself excluded). Iterative, shortcuts nest deeply.
+    void unpackArc(int from, int to, int middle, std::vector<int>& path) const {
+        struct Segment {
+            int from;
+            int to;
+            int middle;
+        };
+
+        std::vector<Segment> stack = { { from, to, middle } };
+        while (!stack.empty()) {
+            Segment segment = stack.back();
+            stack.pop_back();
+
+            if (segment.middle == -1) {
+                path.push_back(segment.to);
+                continue;
+            }
+
+            int middleNode = segment.middle;
+            int firstMiddle = -1, secondMiddle = -1;
+
+            // from -> middle is stored reversed in the downward list of middle
+            for (int arc = _downward.getFirstArc(middleNode); arc < _downward.getLastArc(middleNode); arc++) {
+                if (_downward.getTarget(arc) == segment.from) {
+                    firstMiddle = getDownMiddle(arc);
+                    break;
+                }
+            }
+            for (int arc = _upward.getFirstArc(middleNode); arc < _upward.getLastArc(middleNode); arc++) {
+                if (_upward.getTarget(arc) == segment.to) {
+                    secondMiddle = getUpMiddle(arc);
+                    break;
+                }
+            }
+
+            // the first half is unpacked first
+            stack.push_back({ middleNode, segment.to, secondMiddle });
+            stack.push_back({ segment.from, middleNode, firstMiddle });
+        }
+    }
+
+private:
+    int _numNodes{};
+    int _numShortcuts{};
+    CsrGraph _upward;
+    CsrGraph _downward;
+    const int* _ranks = nullptr;
+    const int* _upMiddles = nullptr;
+    const int* _downMiddles = nullptr;
+    std::shared_ptr<const void> _storage;
+};
+
+// Builds the hierarchy by contracting one node at a time:
+//
+//   order     a min-heap on the priority
+//                 2 * edgeDifference + contractedNeighbours + level
+//             where edgeDifference = shortcuts needed - arcs removed and level
+//             is the depth of the node in the hierarchy so far. The last two
+//             terms spread the contraction evenly over the graph. After a
+//             contraction the priorities of the neighbours are recomputed,
+//             and a popped node whose recomputed priority is no longer the
+//             minimum goes back into the heap (lazy update).
+//   witness   for every arc u -> v into the contracted node v, a Dijkstra from
+//             u that skips v and stops once all out-neighbours of v are
+//             settled, the longest u -> v -> w path is exceeded or
+//             maxWitnessSettled nodes are settled. u -> v -> w becomes a
+//             shortcut unless the search found a path to w that is not longer.
+//             A search stopped by the limit only costs an unneeded shortcut,
+//             never a wrong distance.
+class ContractionHierarchyBuilder {
+public:
+    explicit ContractionHierarchyBuilder(const CsrGraph& graph, int maxWitnessSettled = 500) :
+        _numNodes(graph.getNumNodes()), _maxWitnessSettled(maxWitnessSettled),
+        _outArcs(graph.getNumNodes()), _inArcs(graph.getNumNodes()),
+        _contractedNeighbours(graph.getNumNodes(), 0), _levels(graph.getNumNodes(), 0),
+        _witnessDistances(graph.getNumNodes(), std::numeric_limits<int>::max()),
+        _isWitnessTarget(graph.getNumNodes(), 0),
+        _witnessHeap(graph.getNumNodes()) {
+
+        for (int from = 0; from < _numNodes; from++) {
+            for (int arc = graph.getFirstArc(from); arc < graph.getLastArc(from); arc++) {
+                if (graph.getTarget(arc) != from) {
+                    addArc(from, graph.getTarget(arc), graph.getWeight(arc), -1);
+                }
+            }
+        }
+    }
+
+    ContractionHierarchy build() {
+        auto storage = std::make_shared<Storage>();
+        storage->ranks.assign(_numNodes, -1);
+
+        std::vector<CsrEdge> upEdges, downEdges;
+        std::vector<int> upEdgeMiddles, downEdgeMiddles;
+
+        IndexedDaryHeap<int> order(_numNodes);
+        for (int node = 0; node < _numNodes; node++) {
+            order.push(node, computePriority(node));
+        }
+
+        int numShortcuts{};
+        int nextRank{};
+        std::vector<int> neighbours;
+
+        while (!order.empty()) {
+            int node = order.pop();
+
+            int priority = computePriority(node);
+            if (!order.empty() && priority > order.topKey()) {
+                order.push(node, priority);
+                continue;
+            }
+
+            // computePriority left the shortcuts of the node in _scratchShortcuts
+            storage->ranks[node] = nextRank++;
+
+            // every arc left at the node leads to a node that is contracted later
+            neighbours.clear();
+            for (const HierarchyArc& arc : _outArcs[node]) {
+                upEdges.emplace_back(node, arc.node, arc.weight);
+                upEdgeMiddles.push_back(arc.middle);
+                removeArc(_inArcs[arc.node], node);
+                neighbours.push_back(arc.node);
+            }
+            for (const HierarchyArc& arc : _inArcs[node]) {
+                downEdges.emplace_back(node, arc.node, arc.weight);
+                downEdgeMiddles.push_back(arc.middle);
+                removeArc(_outArcs[arc.node], node);
+                neighbours.push_back(arc.node);
+            }
+
+            for (const Shortcut& shortcut : _scratchShortcuts) {
+                numShortcuts += addArc(shortcut.from, shortcut.to, shortcut.weight, node) ? 1 : 0;
+            }
+
+            std::vector<HierarchyArc>().swap(_outArcs[node]);
+            std::vector<HierarchyArc>().swap(_inArcs[node]);
+
+            std::sort(neighbours.begin(), neighbours.end());
+            neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+            for (const int neighbour : neighbours) {
+                _contractedNeighbours[neighbour]++;
+                _levels[neighbour] = std::max(_levels[neighbour], _levels[node] + 1);
+                order.updateKey(neighbour, computePriority(neighbour));
+            }
+        }
+
+        CsrGraph upward(_numNodes, upEdges);
+        CsrGraph downward(_numNodes, downEdges);
+
+        storage->upMiddles = middlesByArc(upward, upEdgeMiddles);
+        storage->downMiddles = middlesByArc(downward, downEdgeMiddles);
+
+        const int* ranks = storage->ranks.data();
+        const int* upMiddles = storage->upMiddles.data();
+        const int* downMiddles = storage->downMiddles.data();
+
+        return ContractionHierarchy::fromParts(_numNodes, numShortcuts, std::move(upward), std::move(downward),
+                                               ranks, upMiddles, downMiddles, std::move(storage));
+    }
+
+private:
+    struct HierarchyArc {
+        int node;
+        int weight;
+        int middle;
+    };
+
+    struct Shortcut {
+        int from;
+        int to;
+        int weight;
+    };
+
+    struct Storage {
+        std::vector<int> ranks;
+        std::vector<int> upMiddles;
+        std::vector<int> downMiddles;
+    };
+
+    // keeps only the cheapest of parallel arcs, returns true when a new arc was added
+    bool addArc(int from, int to, int weight, int middle) {
+        for (HierarchyArc& arc : _outArcs[from]) {
+            if (arc.node != to) {
+                continue;
+            }
+
+            if (weight < arc.weight) {
+                arc.weight = weight;
+                arc.middle = middle;
+                for (HierarchyArc& inArc : _inArcs[to]) {
+                    if (inArc.node == from) {
+                        inArc.weight = weight;
+                        inArc.middle = middle;
+                    }
+                }
+            }
+            return false;
+        }
+
+        _outArcs[from].push_back({ to, weight, middle });
+        _inArcs[to].push_back({ from, weight, middle });
+        return true;
+    }
+
+    static void removeArc(std::vector<HierarchyArc>& arcs, int node) {
+        for (std::size_t i = 0; i < arcs.size(); i++) {
+            if (arcs[i].node == node) {
+                arcs[i] = arcs.back();
+                arcs.pop_back();
+                return;
+            }
+        }
+    }
+
+    int computePriority(int node) {
+        findShortcuts(node, _scratchShortcuts);
+        int edgeDifference = static_cast<int>(_scratchShortcuts.size()) -
+                             static_cast<int>(_outArcs[node].size() + _inArcs[node].size());
+        return 2 * edgeDifference + _contractedNeighbours[node] + _levels[node];
+    }
+
+    void findShortcuts(int node, std::vector<Shortcut>& shortcuts) {
+        shortcuts.clear();
+
+        int maxOutWeight = -1;
+        for (const HierarchyArc& outArc : _outArcs[node]) {
+            maxOutWeight = std::max(maxOutWeight, outArc.weight);
+        }
+        if (maxOutWeight < 0) {
+            return;
+        }
+
+        for (const HierarchyArc& outArc : _outArcs[node]) {
+            _isWitnessTarget[outArc.node] = 1;
+        }
+
+        for (const HierarchyArc& inArc : _inArcs[node]) {
+            runWitnessSearch(inArc.node, node, static_cast<long long>(inArc.weight) + maxOutWeight,
+                             static_cast<int>(_outArcs[node].size()));
+
+            for (const HierarchyArc& outArc : _outArcs[node]) {
+                if (outArc.node == inArc.node) {
+                    continue;
+                }
+
+                // a path longer than the largest int is never a shortest one, no shortcut needed
+                long long viaNode = static_cast<long long>(inArc.weight) + outArc.weight;
+                if (viaNode < std::numeric_limits<int>::max() && _witnessDistances[outArc.node] > viaNode) {
+                    shortcuts.push_back({ inArc.node, outArc.node, static_cast<int>(viaNode) });
+                }
+            }
+        }
+
+        for (const HierarchyArc& outArc : _outArcs[node]) {
+            _isWitnessTarget[outArc.node] = 0;
+        }
+    }
+
+    // bounded Dijkstra on the remaining graph without skipNode, done once all numTargets targets are settled
+    void runWitnessSearch(int source, int skipNode, long long maxDistance, int numTargets) {
+        for (const int node : _witnessTouched) {
+            _witnessDistances[node] = std::numeric_limits<int>::max();
+        }
+        _witnessTouched.clear();
+        _witnessHeap.clear();
+
+        _witnessDistances[source] = 0;
+        _witnessTouched.push_back(source);
+        _witnessHeap.push(source, 0);
+
+        int numSettled{};
+        while (!_witnessHeap.empty() && _witnessHeap.topKey() <= maxDistance && numSettled < _maxWitnessSettled) {
+            int minNode = _witnessHeap.pop();
+            int minDistance = _witnessDistances[minNode];
+            numSettled++;
+
+            if (_isWitnessTarget[minNode] && --numTargets == 0) {
+                break;
+            }
+
+            for (const HierarchyArc& arc : _outArcs[minNode]) {
+                if (arc.node == skipNode) {
+                    continue;
+                }
+
+                int newDistance = MinPlus<int>::extend(minDistance, arc.weight);
+                if (newDistance < _witnessDistances[arc.node]) {
+                    if (_witnessDistances[arc.node] == std::numeric_limits<int>::max()) {
+                        _witnessTouched.push_back(arc.node);
+                    }
+                    _witnessDistances[arc.node] = newDistance;
+                    _witnessHeap.pushOrDecrease(arc.node, newDistance);
+                }
+            }
+        }
+    }
+
+    static std::vector<int> middlesByArc(const CsrGraph& graph, const std::vector<int>& edgeMiddles) {
+        std::vector<int> middles(graph.getNumArcs());
+        for (int arc = 0; arc < graph.getNumArcs(); arc++) {
+            middles[arc] = edgeMiddles[graph.getEdgeId(arc)];
+        }
+        return middles;
+    }
+
+    int _numNodes{};
+    int _maxWitnessSettled{};
+
+    std::vector<std::vector<HierarchyArc>> _outArcs;
+    std::vector<std::vector<HierarchyArc>> _inArcs;
+    std::vector<int> _contractedNeighbours;
+    std::vector<int> _levels;
+
+    std::vector<int> _witnessDistances;
+    std::vector<int> _witnessTouched;
+    std::vector<char> _isWitnessTarget;
+    IndexedDaryHeap<int> _witnessHeap;
+    std::vector<Shortcut> _scratchShortcuts;
+};
+
+inline ContractionHierarchy buildContractionHierarchy(const CsrGraph& graph, int maxWitnessSettled = 500) {
+    return ContractionHierarchyBuilder(graph, maxWitnessSettled).build();
+}
+
+// Bidirectional upward search. The forward search runs over upward from
+// start, the backward search over downward from dest; the side with the
+// smaller queue head advances, a side stops once its head reaches the best
+// meeting distance. Stall-on-demand skips the arcs of a node that is reached
+// cheaper through a higher ranked neighbour, since it can not be on a shortest
+// up-down path. Labels are reset per touched node, so a query only costs the
+// few hundred nodes it explores. One query object per thread.
+class ContractionHierarchyQuery {
+public:
+    explicit ContractionHierarchyQuery(const ContractionHierarchy& hierarchy) :
+        _hierarchy(hierarchy), _forward(hierarchy.getNumNodes()), _backward(hierarchy.getNumNodes()) {}
+
+    // distance and, unless withPath is false, the unpacked path start ... dest
+    PointToPointResult findShortestPath(int startNode, int destNode, bool withPath = true) {
+        const long long INF = std::numeric_limits<int>::max();
+
+        _forward.reset();
+        _backward.reset();
+
+        PointToPointResult result;
+        _forward.label(startNode, 0, -1);
+        _forward.heap.push(startNode, 0);
+        _backward.label(destNode, 0, -1);
+        _backward.heap.push(destNode, 0);
+
+        long long bestDistance = INF;
+        int meetingNode = -1;
+
+        while (true) {
+            long long forwardTop = _forward.heap.empty() ? INF : _forward.heap.topKey();
+            long long backwardTop = _backward.heap.empty() ? INF : _backward.heap.topKey();
+            if (std::min(forwardTop, backwardTop) >= bestDistance) {
+                break;
+            }
+
+            bool isForward = forwardTop <= backwardTop;
+            SearchSide& side = isForward ? _forward : _backward;
+            SearchSide& other = isForward ? _backward : _forward;
+            const CsrGraph& searchGraph = isForward ? _hierarchy.getUpward() : _hierarchy.getDownward();
+            const CsrGraph& stallGraph = isForward ? _hierarchy.getDownward() : _hierarchy.getUpward();
+
+            int minNode = side.heap.pop();
+            int minDistance = side.distances[minNode];
+            result.numSettled++;
+
+            if (other.distances[minNode] != INF &&
+                static_cast<long long>(minDistance) + other.distances[minNode] < bestDistance) {
+                bestDistance = static_cast<long long>(minDistance) + other.distances[minNode];
+                meetingNode = minNode;
+            }
+
+            if (isStalled(side, stallGraph, minNode, minDistance)) {
+                continue;
+            }
+
+            for (int arc = searchGraph.getFirstArc(minNode); arc < searchGraph.getLastArc(minNode); arc++) {
+                int child = searchGraph.getTarget(arc);
+                int newDistance = MinPlus<int>::extend(minDistance, searchGraph.getWeight(arc));
+                if (newDistance < side.distances[child]) {
+                    side.label(child, newDistance, arc);
+                    side.heap.pushOrDecrease(child, newDistance);
+                }
+            }
+        }
+
+        if (meetingNode == -1) {
+            return result;
+        }
+
+        result.distance = static_cast<int>(bestDistance);
+        if (withPath) {
+            result.path = unpackPath(startNode, meetingNode);
+        }
+
+        return result;
+    }
+
+private:
+    struct SearchSide {
+        std::vector<int> distances;
+        std::vector<int> prevArcs;
+        std::vector<int> touched;
+        IndexedDaryHeap<int> heap;
+
+        explicit SearchSide(int numNodes) :
+            distances(numNodes, std::numeric_limits<int>::max()), prevArcs(numNodes, -1), heap(numNodes) {}
+
+        void label(int node, int distance, int prevArc) {
+            if (distances[node] == std::numeric_limits<int>::max()) {
+                touched.push_back(node);
+            }
+            distances[node] = distance;
+            prevArcs[node] = prevArc;
+        }
+
+        void reset() {
+            for (const int node : touched) {
+                distances[node] = std::numeric_limits<int>::max();
+                prevArcs[node] = -1;
+            }
+            touched.clear();
+            heap.clear();
+        }
+    };
+
+    // a higher neighbour reaches node cheaper than the search did
+    static bool isStalled(const SearchSide& side, const CsrGraph& stallGraph, int node, int distance) {
+        for (int arc = stallGraph.getFirstArc(node); arc < stallGraph.getLastArc(node); arc++) {
+            int neighbour = side.distances[stallGraph.getTarget(arc)];
+            if (neighbour != std::numeric_limits<int>::max() &&
+                static_cast<long long>(neighbour) + stallGraph.getWeight(arc) < distance) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<int> unpackPath(int startNode, int meetingNode) const {
+        const CsrGraph& upward = _hierarchy.getUpward();
+        const CsrGraph& downward = _hierarchy.getDownward();
+
+        // hierarchy arcs start -> meeting node, collected backwards
+        std::vector<int> upArcs;
+        for (int node = meetingNode; _forward.prevArcs[node] != -1; node = upward.findSource(_forward.prevArcs[node])) {
+            upArcs.push_back(_forward.prevArcs[node]);
+        }
+
+        std::vector<int> path = { startNode };
+        for (auto it = upArcs.rbegin(); it != upArcs.rend(); ++it) {
+            int arc = *it;
+            _hierarchy.unpackArc(upward.findSource(arc), upward.getTarget(arc), _hierarchy.getUpMiddle(arc), path);
+        }
+
+        // the backward labels lead from the meeting node down to dest
+        for (int node = meetingNode; _backward.prevArcs[node] != -1; ) {
+            int arc = _backward.prevArcs[node];
+            int next = downward.findSource(arc);
+            _hierarchy.unpackArc(node, next, _hierarchy.getDownMiddle(arc), path);
+            node = next;
+        }
+
+        return path;
+    }
+
+    const ContractionHierarchy& _hierarchy;
+    SearchSide _forward;
+    SearchSide _backward;
+};
+
+// Hierarchy file (.chg), little endian:
+//
+//   ContractionHierarchyHeader (64 bytes)
+//   int32 ranks[numNodes]
+//   upward:   int32 offsets[numNodes + 1], targets / weights / edgeIds / middles[numUpArcs]
+//   downward: int32 offsets[numNodes + 1], targets / weights / edgeIds / middles[numDownArcs]
+//
+// Loading maps the file like a binary graph, the query runs straight on the mapping.
+
+constexpr char HIERARCHY_MAGIC[8] = { 'C', 'H', 'I', 'E', 'R', 'A', 'R', 'C' };
+constexpr std::uint32_t HIERARCHY_VERSION = 1;
+
+struct ContractionHierarchyHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::uint64_t numNodes;
+    std::uint64_t numUpArcs;
+    std::uint64_t numDownArcs;
+    std::uint64_t numShortcuts;
+    std::uint64_t reserved[2];
+};
+
+static_assert(sizeof(ContractionHierarchyHeader) == 64, "the header is part of the file format");
+
+inline void saveContractionHierarchy(const ContractionHierarchy& hierarchy, const std::string& path) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("Can not create " + path);
+    }
+
+    const CsrGraph& upward = hierarchy.getUpward();
+    const CsrGraph& downward = hierarchy.getDownward();
+
+    ContractionHierarchyHeader header{};
+    std::memcpy(header.magic, HIERARCHY_MAGIC, sizeof(header.magic));
+    header.version = HIERARCHY_VERSION;
+    header.numNodes = hierarchy.getNumNodes();
+    header.numUpArcs = upward.getNumArcs();
+    header.numDownArcs = downward.getNumArcs();
+    header.numShortcuts = hierarchy.getNumShortcuts();
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    auto writeArray = [&out](const int* data, std::size_t count) {
+        out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(int)));
+    };
+
+    std::vector<int> ranks(hierarchy.getNumNodes());
+    for (int node = 0; node < hierarchy.getNumNodes(); node++) {
+        ranks[node] = hierarchy.getRank(node);
+    }
+    writeArray(ranks.data(), ranks.size());
+
+    auto writeGraph = [&](const CsrGraph& graph, bool isUpward) {
+        const CsrArrays& arrays = graph.getArrays();
+        std::size_t numArcs = graph.getNumArcs();
+
+        std::vector<int> middles(numArcs);
+        for (std::size_t arc = 0; arc < numArcs; arc++) {
+            middles[arc] = isUpward ? hierarchy.getUpMiddle(static_cast<int>(arc))
+                                    : hierarchy.getDownMiddle(static_cast<int>(arc));
+        }
+
+        writeArray(arrays.offsets, graph.getNumNodes() + 1);
+        writeArray(arrays.targets, numArcs);
+        writeArray(arrays.weights, numArcs);
+        writeArray(arrays.edgeIds, numArcs);
+        writeArray(middles.data(), numArcs);
+    };
+
+    writeGraph(upward, true);
+    writeGraph(downward, false);
+
+    if (!out) {
+        throw std::runtime_error("Can not write " + path);
+    }
+}
+
+inline ContractionHierarchy loadContractionHierarchy(const std::string& path) {
+    auto file = std::make_shared<MappedFile>(path);
+
+    ContractionHierarchyHeader header{};
+    if (file->getSize() < sizeof(header)) {
+        throw std::runtime_error(path + " is not a contraction hierarchy file");
+    }
+    std::memcpy(&header, file->getData(), sizeof(header));
+
+    if (std::memcmp(header.magic, HIERARCHY_MAGIC, sizeof(header.magic)) != 0) {
+        throw std::runtime_error(path + " is not a contraction hierarchy file");
+    }
+    if (header.version != HIERARCHY_VERSION) {
+        throw std::runtime_error(path + " has unsupported format version " + std::to_string(header.version));
+    }
+
+    std::uint64_t numInts = header.numNodes + 2 * (header.numNodes + 1) +
+                            4 * (header.numUpArcs + header.numDownArcs);
+    if (file->getSize() < sizeof(header) + numInts * sizeof(int)) {
+        throw std::runtime_error(path + " is truncated");
+    }
+
+    int numNodes = static_cast<int>(header.numNodes);
+    const int* ranks = reinterpret_cast<const int*>(file->getData() + sizeof(header));
+
+    const int* next = ranks + numNodes;
+    auto mapGraph = [&](int numArcs, const int*& middles) {
+        CsrArrays arrays;
+        arrays.offsets = next;
+        arrays.targets = arrays.offsets + (numNodes + 1);
+        arrays.weights = arrays.targets + numArcs;
+        arrays.edgeIds = arrays.weights + numArcs;
+        middles = arrays.edgeIds + numArcs;
+        next = middles + numArcs;
+        return CsrGraph::fromArrays(numNodes, numArcs, numArcs, false, arrays, file);
+    };
+
+    const int* upMiddles = nullptr;
+    const int* downMiddles = nullptr;
+    CsrGraph upward = mapGraph(static_cast<int>(header.numUpArcs), upMiddles);
+    CsrGraph downward = mapGraph(static_cast<int>(header.numDownArcs), downMiddles);
+
+    return ContractionHierarchy::fromParts(numNodes, static_cast<int>(header.numShortcuts), std::move(upward),
+                                           std::move(downward), ranks, upMiddles, downMiddles, std::move(file));
+}
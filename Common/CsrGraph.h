@@ -0,0 +1,237 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
+
+// plain (from, to, weight) triple that every graph in the repo is read into
+template <typename Weight>
+struct BasicCsrEdge {
+    int from{};
+    int to{};
+    Weight weight{};
+
+    BasicCsrEdge() = default;
+
+    BasicCsrEdge(int src, int dest, Weight inWeight) :
+        from(src), to(dest), weight(inWeight) {}
+};
+
+// raw arrays of a CSR graph, see BasicCsrGraph::fromArrays
+template <typename Weight>
+struct BasicCsrArrays {
+    const int* offsets = nullptr;
+    const int* targets = nullptr;
+    const Weight* weights = nullptr;
+    const int* edgeIds = nullptr;
+
+    const int* revOffsets = nullptr;
+    const int* revSources = nullptr;
+    const Weight* revWeights = nullptr;
+    const int* revEdgeIds = nullptr;
+};
+
+// Compressed sparse row graph. The outgoing arcs of node u occupy the slots
+// [offsets[u], offsets[u + 1]) of targets / weights / edgeIds, so an
+// adjacency scan is a sequential walk over three contiguous arrays. Memory is
+// O(V + E) instead of the O(V^2) of an adjacency matrix.
+//
+// edgeId of an arc is the index of the input edge it was built from - for
+// undirected graphs both arcs of an edge share the same id.
+//
+// The optional reverse CSR holds the incoming arcs of every node in the same
+// layout (source instead of target).
+//
+// The graph is immutable. The arrays live in a shared block - either built
+// here or a memory-mapped binary graph file (BinaryGraphFormat.h) - so copies
+// are cheap and share the data.
+//
+// Weight is the arc weight type (int, std::uint32_t, std::int64_t, float,
+// double, ...), fixed at compile time so the algorithms templated on it
+// (Semiring.h) get code for exactly that type. CsrGraph is the int graph
+// that the programs and the binary graph format use.
+template <typename Weight>
+class BasicCsrGraph {
+public:
+    using WeightType = Weight;
+    using Edge = BasicCsrEdge<Weight>;
+    using Arrays = BasicCsrArrays<Weight>;
+
+    BasicCsrGraph() = default;
+
+    BasicCsrGraph(int numNodes, const std::vector<Edge>& edges, bool undirected = false, bool withReverse = false) {
+        build(numNodes, edges, undirected, withReverse);
+    }
+
+    // wraps arrays owned by storage (e.g. a file mapping) without copying them
+    static BasicCsrGraph fromArrays(int numNodes, int numArcs, int numEdges, bool undirected,
+                                    const Arrays& arrays, std::shared_ptr<const void> storage) {
+        BasicCsrGraph graph;
+        graph._numNodes = numNodes;
+        graph._numArcs = numArcs;
+        graph._numEdges = numEdges;
+        graph._undirected = undirected;
+        graph._arrays = arrays;
+        graph._storage = std::move(storage);
+        return graph;
+    }
+
+    int getNumNodes() const { return _numNodes; }
+    int getNumArcs() const { return _numArcs; }
+    int getNumEdges() const { return _numEdges; }
+    bool isUndirected() const { return _undirected; }
+    bool hasReverse() const { return _arrays.revOffsets != nullptr; }
+
+    // outgoing arcs
+    int getFirstArc(int node) const { return _arrays.offsets[node]; }
+    int getLastArc(int node) const { return _arrays.offsets[node + 1]; }
+    int getOutDegree(int node) const { return _arrays.offsets[node + 1] - _arrays.offsets[node]; }
+    int getTarget(int arc) const { return _arrays.targets[arc]; }
+    Weight getWeight(int arc) const { return _arrays.weights[arc]; }
+    int getEdgeId(int arc) const { return _arrays.edgeIds[arc]; }
+
+    // incoming arcs, only valid when hasReverse()
+    int getFirstInArc(int node) const { return _arrays.revOffsets[node]; }
+    int getLastInArc(int node) const { return _arrays.revOffsets[node + 1]; }
+    int getInDegree(int node) const { return _arrays.revOffsets[node + 1] - _arrays.revOffsets[node]; }
+    int getInSource(int inArc) const { return _arrays.revSources[inArc]; }
+    Weight getInWeight(int inArc) const { return _arrays.revWeights[inArc]; }
+    int getInEdgeId(int inArc) const { return _arrays.revEdgeIds[inArc]; }
+
+    const Arrays& getArrays() const { return _arrays; }
+
+    // source node of an arc, binary search over the offsets
+    int findSource(int arc) const {
+        const int* it = std::upper_bound(_arrays.offsets, _arrays.offsets + _numNodes + 1, arc);
+        return static_cast<int>(it - _arrays.offsets) - 1;
+    }
+
+    // the input edges in input order, each undirected edge once
+    std::vector<Edge> toEdgeList() const {
+        std::vector<Edge> edges(_numEdges);
+        std::vector<bool> seen(_numEdges, false);
+
+        for (int node = 0; node < _numNodes; node++) {
+            for (int arc = getFirstArc(node); arc < getLastArc(node); arc++) {
+                int id = getEdgeId(arc);
+                if (!seen[id]) {
+                    seen[id] = true;
+                    edges[id] = Edge(node, getTarget(arc), getWeight(arc));
+                }
+            }
+        }
+
+        return edges;
+    }
+
+private:
+    // offsets, targets and edge ids (+ the same for the reverse CSR) in one int block, the weights in their own
+    struct Storage {
+        std::vector<int> ints;
+        std::vector<Weight> weights;
+    };
+
+    void build(int numNodes, const std::vector<Edge>& edges, bool undirected, bool withReverse) {
+        _numNodes = numNodes;
+        _numEdges = static_cast<int>(edges.size());
+        _numArcs = undirected ? 2 * _numEdges : _numEdges;
+        _undirected = undirected;
+
+        std::size_t numInts = (numNodes + 1) + 2 * static_cast<std::size_t>(_numArcs);
+        std::size_t numWeights = _numArcs;
+        if (withReverse) {
+            numInts *= 2;
+            numWeights *= 2;
+        }
+        auto storage = std::make_shared<Storage>();
+        storage->ints.resize(numInts);
+        storage->weights.resize(numWeights);
+
+        int* offsets = storage->ints.data();
+        int* targets = offsets + (numNodes + 1);
+        int* edgeIds = targets + _numArcs;
+        Weight* weights = storage->weights.data();
+
+        // counting sort of the arcs by source node - O(V + E)
+        std::fill(offsets, offsets + numNodes + 1, 0);
+        for (const Edge& edge : edges) {
+            offsets[edge.from + 1]++;
+            if (undirected) {
+                offsets[edge.to + 1]++;
+            }
+        }
+
+        for (int node = 0; node < numNodes; node++) {
+            offsets[node + 1] += offsets[node];
+        }
+
+        std::vector<int> nextSlot(offsets, offsets + numNodes);
+        for (int id = 0; id < _numEdges; id++) {
+            const Edge& edge = edges[id];
+            placeArc(nextSlot, targets, weights, edgeIds, edge.from, edge.to, edge.weight, id);
+            if (undirected) {
+                placeArc(nextSlot, targets, weights, edgeIds, edge.to, edge.from, edge.weight, id);
+            }
+        }
+
+        _arrays.offsets = offsets;
+        _arrays.targets = targets;
+        _arrays.weights = weights;
+        _arrays.edgeIds = edgeIds;
+
+        if (withReverse) {
+            buildReverse(edgeIds + _numArcs, weights + _numArcs);
+        }
+
+        _storage = std::move(storage);
+    }
+
+    void buildReverse(int* revOffsets, Weight* revWeights) {
+        int* revSources = revOffsets + (_numNodes + 1);
+        int* revEdgeIds = revSources + _numArcs;
+
+        std::fill(revOffsets, revOffsets + _numNodes + 1, 0);
+        for (int arc = 0; arc < _numArcs; arc++) {
+            revOffsets[getTarget(arc) + 1]++;
+        }
+
+        for (int node = 0; node < _numNodes; node++) {
+            revOffsets[node + 1] += revOffsets[node];
+        }
+
+        // walking the sources in order keeps every in-arc list sorted by source
+        std::vector<int> nextSlot(revOffsets, revOffsets + _numNodes);
+        for (int node = 0; node < _numNodes; node++) {
+            for (int arc = getFirstArc(node); arc < getLastArc(node); arc++) {
+                placeArc(nextSlot, revSources, revWeights, revEdgeIds,
+                         getTarget(arc), node, getWeight(arc), getEdgeId(arc));
+            }
+        }
+
+        _arrays.revOffsets = revOffsets;
+        _arrays.revSources = revSources;
+        _arrays.revWeights = revWeights;
+        _arrays.revEdgeIds = revEdgeIds;
+    }
+
+    static void placeArc(std::vector<int>& nextSlot, int* ends, Weight* weights, int* ids,
+                         int node, int end, Weight weight, int id) {
+        int slot = nextSlot[node]++;
+        ends[slot] = end;
+        weights[slot] = weight;
+        ids[slot] = id;
+    }
+
+    int _numNodes{};
+    int _numArcs{};
+    int _numEdges{};
+    bool _undirected = false;
+
+    Arrays _arrays;
+    std::shared_ptr<const void> _storage;
+};
+
+using CsrEdge = BasicCsrEdge<int>;
+using CsrArrays = BasicCsrArrays<int>;
+using CsrGraph = BasicCsrGraph<int>;
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+
+#include "CsrGraph.h"
+#include "Semiring.h"
+#include "TopologicalSort.h"
+#include "Parallel.h"
+
+// Single-source paths of a DAG for a path semiring (Semiring.h) - MaxPlus
+// for longest, MinPlus for shortest paths - one node at a time in
+// topological order: every reached node pushes its distance along its
+// out-arcs, a child only takes a strictly better distance. Unreached nodes
+// keep Semiring::zero(). O(V + E).
+template <typename Semiring>
+void relaxDagInTopologicalOrder(const BasicCsrGraph<typename Semiring::WeightType>& graph,
+                                const TopologicalOrder& sortedNodes, int startNode,
+                                std::vector<typename Semiring::WeightType>& distances, std::vector<int>& prevs) {
+    using Weight = typename Semiring::WeightType;
+
+    distances.assign(graph.getNumNodes(), Semiring::zero());
+    prevs.assign(graph.getNumNodes(), -1);
+    distances[startNode] = Semiring::one();
+
+    for (const int node : sortedNodes.order) {
+        if (distances[node] == Semiring::zero()) {
+            continue;
+        }
+
+        for (int arc = graph.getFirstArc(node); arc < graph.getLastArc(node); arc++) {
+            // relaxation step
+            int child = graph.getTarget(arc);
+            Weight newDistance = Semiring::extend(distances[node], graph.getWeight(arc));
+            if (Semiring::isBetter(newDistance, distances[child])) {
+                distances[child] = newDistance;
+                prevs[child] = node;
+            }
+        }
+    }
+}
+
+// Same result as relaxDagInTopologicalOrder, computed one topological level
+// at a time. A level is an antichain, so all predecessors of its nodes are
+// final and every node can pull its distance from its in-arcs (reverse CSR)
+// independently - the nodes of a level are split across threads and each
+// thread only writes the labels of its own nodes, no atomics needed.
+//
+// The push version keeps the first predecessor (in topological order) that
+// reaches the best distance, so among equal candidates the pull takes the one
+// with the smallest topological position - distances and prevs are identical.
+//
+// Levels smaller than minParallelLevel run on the calling thread, which keeps
+// long narrow DAGs from paying a thread fork per level.
+template <typename Semiring>
+void relaxDagByLevels(const BasicCsrGraph<typename Semiring::WeightType>& graph, const TopologicalOrder& sortedNodes,
+                      int startNode, std::vector<typename Semiring::WeightType>& distances, std::vector<int>& prevs,
+                      int numThreads = getDefaultNumThreads(), int minParallelLevel = 4096) {
+    using Weight = typename Semiring::WeightType;
+
+    if (!graph.hasReverse()) {
+        throw std::runtime_error("relaxDagByLevels needs a graph with a reverse CSR");
+    }
+
+    int numNodes = graph.getNumNodes();
+
+    std::vector<int> positions(numNodes);
+    for (int i = 0; i < static_cast<int>(sortedNodes.order.size()); i++) {
+        positions[sortedNodes.order[i]] = i;
+    }
+
+    distances.assign(numNodes, Semiring::zero());
+    prevs.assign(numNodes, -1);
+
+    auto pullLabel = [&](int node) {
+        if (node == startNode) {
+            distances[node] = Semiring::one();
+            return;
+        }
+
+        Weight bestDistance = Semiring::zero();
+        int bestPrev = -1;
+
+        for (int inArc = graph.getFirstInArc(node); inArc < graph.getLastInArc(node); inArc++) {
+            int source = graph.getInSource(inArc);
+            if (distances[source] == Semiring::zero()) {
+                continue;
+            }
+
+            Weight newDistance = Semiring::extend(distances[source], graph.getInWeight(inArc));
+            if (Semiring::isBetter(newDistance, bestDistance) ||
+                (newDistance == bestDistance && bestPrev != -1 && positions[source] < positions[bestPrev])) {
+                bestDistance = newDistance;
+                bestPrev = source;
+            }
+        }
+
+        distances[node] = bestDistance;
+        prevs[node] = bestPrev;
+    };
+
+    for (int level = 0; level < sortedNodes.getNumLevels(); level++) {
+        int levelBegin = sortedNodes.levelOffsets[level];
+        int levelEnd = sortedNodes.levelOffsets[level + 1];
+        int levelSize = levelEnd - levelBegin;
+
+        parallelForChunks(levelSize, levelSize < minParallelLevel ? 1 : numThreads,
+                          [&](int, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                pullLabel(sortedNodes.order[levelBegin + i]);
+            }
+        });
+    }
+}
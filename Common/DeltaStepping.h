@@ -0,0 +1,412 @@
+#pragma once
+
+#include <queue>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <limits>
+#include <utility>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
+
+#include "CsrGraph.h"
+#include "Parallel.h"
+#include "RadixSort.h"
+#include "Semiring.h"
+
+// Bucket width for delta-stepping picked from the weights: the 1/d quantile
+// of a sample of arc weights for an average out-degree d. For uniform weights
+// up to W that is the classic W / d - a node then has about one light arc,
+// few relaxations are repeated inside a bucket and the buckets still hold
+// enough nodes to split across threads. Skewed weights move the quantile with
+// them instead of following one huge weight.
+template <typename Weight>
+Weight chooseDeltaStepWidth(const BasicCsrGraph<Weight>& graph) {
+    constexpr int MAX_SAMPLES = 65536;
+
+    int numArcs = graph.getNumArcs();
+    if (numArcs == 0) {
+        return 1;
+    }
+
+    // evenly spaced arcs, the same sample on every run
+    int numSamples = std::min(numArcs, MAX_SAMPLES);
+    std::vector<Weight> samples(numSamples);
+    for (int i = 0; i < numSamples; i++) {
+        samples[i] = graph.getWeight(static_cast<int>(static_cast<long long>(i) * numArcs / numSamples));
+    }
+
+    double averageDegree = static_cast<double>(numArcs) / std::max(1, graph.getNumNodes());
+    int quantile = std::min(numSamples - 1, static_cast<int>(numSamples / std::max(1.0, averageDegree)));
+    std::nth_element(samples.begin(), samples.begin() + quantile, samples.end());
+
+    return std::max<Weight>(1, samples[quantile]);
+}
+
+// Parallel single-source shortest paths for non-negative integer weights
+// (Meyer-Sanders delta-stepping). Tentative distances are kept in buckets of
+// width delta; the lowest non-empty bucket is settled in phases:
+//   1. light arcs (weight <= delta) of all its nodes are relaxed in parallel,
+//      nodes that improve within the bucket come back for another phase,
+//   2. once it stays empty, the heavy arcs of every node it held are relaxed
+//      in parallel - they can only reach later buckets, so once is enough.
+// Relaxations are atomic minimums on the distances; nodes that improved are
+// collected per chunk and moved to their buckets by the calling thread.
+// Phases with fewer than minParallelFrontier nodes run on the calling thread.
+//
+// The distances do not depend on the order of the relaxations, the prevs of
+// the race do - so they are not taken from it. Once the distances are final,
+// every node gets the prev Dijkstra (Dijkstra.h) would give it: the first
+// settled of its predecessors on a shortest arc. Dijkstra settles by
+// (distance, node id), so the settle order is a sort by distance with ids in
+// ascending order; only zero-weight arcs inside a group of equal distances
+// change it, those groups are replayed as Dijkstra would pop them. Distances
+// and prevs are identical to runDijkstra for every delta and thread count.
+//
+// The arcs are copied once, light ones first for every node, and the solver
+// keeps its buffers between runs - build it once per graph and delta.
+// Unreachable nodes keep MinPlus<Weight>::zero() and prev -1.
+template <typename Weight = int>
+class DeltaStepping {
+    static_assert(std::is_integral_v<Weight>, "Delta-stepping needs integer weights");
+
+    static constexpr int MAX_BUCKETS = 65536;
+
+public:
+    using Semiring = MinPlus<Weight>;
+
+    // delta 0 is chosen by chooseDeltaStepWidth
+    explicit DeltaStepping(const BasicCsrGraph<Weight>& graph, Weight delta = 0,
+                           int numThreads = getDefaultNumThreads(), int minParallelFrontier = 1024) :
+        _numNodes(graph.getNumNodes()), _delta(delta > 0 ? delta : chooseDeltaStepWidth(graph)),
+        _numThreads(std::max(1, numThreads)), _minParallelFrontier(minParallelFrontier),
+        _offsets(graph.getNumNodes() + 1), _lightEnds(graph.getNumNodes()),
+        _targets(graph.getNumArcs()), _weights(graph.getNumArcs()),
+        _distances(new std::atomic<Weight>[graph.getNumNodes()]),
+        _queuedBuckets(graph.getNumNodes()), _settledBuckets(graph.getNumNodes()),
+        _chunkImproved(_numThreads) {
+        Weight maxWeight{};
+        for (int node = 0; node < _numNodes; node++) {
+            int arc = graph.getFirstArc(node);
+            _offsets[node] = arc;
+
+            // light arcs to the front, heavy ones to the back of the node's range
+            int lightEnd = arc, heavyBegin = graph.getLastArc(node);
+            for (; arc < graph.getLastArc(node); arc++) {
+                Weight weight = graph.getWeight(arc);
+                if (weight < Weight{}) {
+                    throw std::runtime_error("Delta-stepping needs non-negative weights");
+                }
+                maxWeight = std::max(maxWeight, weight);
+                _hasZeroWeights = _hasZeroWeights || weight == Weight{};
+
+                int slot = weight <= _delta ? lightEnd++ : --heavyBegin;
+                _targets[slot] = graph.getTarget(arc);
+                _weights[slot] = weight;
+            }
+            _lightEnds[node] = lightEnd;
+        }
+        _offsets[_numNodes] = graph.getNumArcs();
+
+        // an arc never reaches further than maxWeight / delta + 1 buckets ahead, so they can be reused
+        // cyclically - up to a limit, a few huge weights send their targets to the far list instead
+        _buckets.resize(static_cast<std::size_t>(std::min<Weight>(maxWeight / _delta, MAX_BUCKETS - 2)) + 2);
+    }
+
+    Weight getDelta() const { return _delta; }
+
+    // Distances and prevs from startNode, returns the number of light phases
+    int run(int startNode, std::vector<Weight>& distances, std::vector<int>& prevs) {
+        distances.assign(_numNodes, Semiring::zero());
+        prevs.assign(_numNodes, -1);
+        std::fill(_queuedBuckets.begin(), _queuedBuckets.end(), -1);
+        std::fill(_settledBuckets.begin(), _settledBuckets.end(), -1);
+        parallelForChunks(_numNodes, _numThreads, [this](int, std::size_t begin, std::size_t end) {
+            for (std::size_t node = begin; node < end; node++) {
+                _distances[node].store(Semiring::zero(), std::memory_order_relaxed);
+            }
+        });
+
+        _distances[startNode].store(Semiring::one(), std::memory_order_relaxed);
+        _bucketIndex = 0;
+        enqueue(startNode);
+
+        int numPhases{};
+        for (; _numQueued > 0 || !_farNodes.empty(); _bucketIndex++) {
+            if (_numQueued == 0) {
+                moveFarNodes();
+            }
+
+            long long bucketIndex = _bucketIndex;
+            std::vector<int>& bucket = _buckets[bucketIndex % _buckets.size()];
+
+            _settled.clear();
+            while (!bucket.empty()) {
+                // entries of nodes that moved to a lower bucket since are stale
+                _frontier.clear();
+                for (const int node : bucket) {
+                    _numQueued--;
+                    if (_queuedBuckets[node] == bucketIndex) {
+                        _queuedBuckets[node] = -1;
+                        _frontier.push_back(node);
+                        if (_settledBuckets[node] != bucketIndex) {
+                            _settledBuckets[node] = bucketIndex;
+                            _settled.push_back(node);
+                        }
+                    }
+                }
+                bucket.clear();
+
+                relaxArcs(_frontier, true);
+                numPhases++;
+            }
+
+            relaxArcs(_settled, false);
+        }
+
+        parallelForChunks(_numNodes, _numThreads, [&](int, std::size_t begin, std::size_t end) {
+            for (std::size_t node = begin; node < end; node++) {
+                distances[node] = _distances[node].load(std::memory_order_relaxed);
+            }
+        });
+
+        findDijkstraPrevs(startNode, distances, prevs);
+        return numPhases;
+    }
+
+private:
+    Weight getDistance(int node) const { return _distances[node].load(std::memory_order_relaxed); }
+
+    void enqueue(int node) {
+        long long bucketIndex = static_cast<long long>(getDistance(node) / _delta);
+        if (_queuedBuckets[node] != bucketIndex) {
+            _queuedBuckets[node] = bucketIndex;
+            pushToBucket(node, bucketIndex);
+        }
+    }
+
+    void pushToBucket(int node, long long bucketIndex) {
+        if (bucketIndex < _bucketIndex + static_cast<long long>(_buckets.size())) {
+            _buckets[bucketIndex % _buckets.size()].push_back(node);
+            _numQueued++;
+        } else {
+            _farNodes.emplace_back(node, bucketIndex);
+        }
+    }
+
+    // the cyclic buckets ran empty: skip ahead to the lowest far bucket and take what fits now
+    void moveFarNodes() {
+        std::vector<std::pair<int, long long>> farNodes;
+        farNodes.swap(_farNodes);
+
+        // a node that moved to another bucket since left a stale entry
+        long long lowestBucket = std::numeric_limits<long long>::max();
+        for (const auto& [node, bucketIndex] : farNodes) {
+            if (_queuedBuckets[node] == bucketIndex) {
+                lowestBucket = std::min(lowestBucket, bucketIndex);
+            }
+        }
+        if (lowestBucket == std::numeric_limits<long long>::max()) {
+            return;
+        }
+        _bucketIndex = lowestBucket;
+
+        for (const auto& [node, bucketIndex] : farNodes) {
+            if (_queuedBuckets[node] == bucketIndex) {
+                pushToBucket(node, bucketIndex);
+            }
+        }
+    }
+
+    int getNumThreads(std::size_t count) const {
+        return count < static_cast<std::size_t>(_minParallelFrontier) ? 1 : _numThreads;
+    }
+
+    // light or heavy arcs of the nodes, the improved targets go to their buckets
+    void relaxArcs(const std::vector<int>& nodes, bool light) {
+        int numThreads = getNumThreads(nodes.size());
+
+        parallelForChunks(nodes.size(), numThreads, [&](int chunk, std::size_t begin, std::size_t end) {
+            std::vector<int>& improved = _chunkImproved[chunk];
+            for (std::size_t i = begin; i < end; i++) {
+                int node = nodes[i];
+                // a stale, larger distance only makes weaker offers - the node is queued again anyway
+                Weight distance = getDistance(node);
+                int first = light ? _offsets[node] : _lightEnds[node];
+                int last = light ? _lightEnds[node] : _offsets[node + 1];
+
+                for (int arc = first; arc < last; arc++) {
+                    int target = _targets[arc];
+                    Weight newDistance = Semiring::extend(distance, _weights[arc]);
+                    Weight current = _distances[target].load(std::memory_order_relaxed);
+                    while (Semiring::isBetter(newDistance, current)) {
+                        if (_distances[target].compare_exchange_weak(current, newDistance,
+                                                                     std::memory_order_relaxed)) {
+                            improved.push_back(target);
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+
+        for (int chunk = 0; chunk < numThreads; chunk++) {
+            for (const int node : _chunkImproved[chunk]) {
+                enqueue(node);
+            }
+            _chunkImproved[chunk].clear();
+        }
+    }
+
+    // prev of every node = its first predecessor on a shortest arc in Dijkstra's settle order
+    void findDijkstraPrevs(int startNode, const std::vector<Weight>& distances, std::vector<int>& prevs) {
+        std::vector<std::uint32_t> order = radixSortIndicesByKey(static_cast<std::size_t>(_numNodes),
+            [&distances](std::size_t node) { return toRadixKey(distances[node]); }, _numThreads);
+
+        // unreachable nodes sort last
+        int numReached = _numNodes;
+        while (numReached > 0 && distances[order[numReached - 1]] == Semiring::zero()) {
+            numReached--;
+        }
+
+        if (_hasZeroWeights) {
+            orderZeroWeightGroups(startNode, distances, order, numReached);
+        }
+
+        std::vector<int> ranks(_numNodes, _numNodes);
+        parallelForChunks(numReached, _numThreads, [&](int, std::size_t begin, std::size_t end) {
+            for (std::size_t rank = begin; rank < end; rank++) {
+                ranks[order[rank]] = static_cast<int>(rank);
+            }
+        });
+
+        // smallest rank of a predecessor on a shortest arc, pushed along the out-arcs
+        std::unique_ptr<std::atomic<int>[]> prevRanks(new std::atomic<int>[_numNodes]);
+        parallelForChunks(_numNodes, _numThreads, [&](int, std::size_t begin, std::size_t end) {
+            for (std::size_t node = begin; node < end; node++) {
+                prevRanks[node].store(_numNodes, std::memory_order_relaxed);
+            }
+        });
+
+        parallelForChunks(numReached, _numThreads, [&](int, std::size_t begin, std::size_t end) {
+            for (std::size_t rank = begin; rank < end; rank++) {
+                int node = order[rank];
+                for (int arc = _offsets[node]; arc < _offsets[node + 1]; arc++) {
+                    int target = _targets[arc];
+                    // a saturated extension equals the distance of an unreachable target
+                    if (distances[target] == Semiring::zero() || ranks[target] <= static_cast<int>(rank) ||
+                        Semiring::extend(distances[node], _weights[arc]) != distances[target]) {
+                        continue;
+                    }
+
+                    int current = prevRanks[target].load(std::memory_order_relaxed);
+                    while (static_cast<int>(rank) < current &&
+                           !prevRanks[target].compare_exchange_weak(current, static_cast<int>(rank),
+                                                                    std::memory_order_relaxed)) {
+                    }
+                }
+            }
+        });
+
+        parallelForChunks(_numNodes, _numThreads, [&](int, std::size_t begin, std::size_t end) {
+            for (std::size_t node = begin; node < end; node++) {
+                int prevRank = prevRanks[node].load(std::memory_order_relaxed);
+                prevs[node] = prevRank == _numNodes ? -1 : static_cast<int>(order[prevRank]);
+            }
+        });
+    }
+
+    // Within a group of equal distances Dijkstra pops by id, but a node
+    // reached only over zero-weight arcs from the group joins the heap when
+    // its predecessor is popped - replayed here with a heap of ids.
+    void orderZeroWeightGroups(int startNode, const std::vector<Weight>& distances,
+                               std::vector<std::uint32_t>& order, int numReached) {
+        // in the heap at the start of its group: reached over a positive arc, or the start node
+        std::unique_ptr<std::atomic<char>[]> queued(new std::atomic<char>[_numNodes]);
+        parallelForChunks(_numNodes, _numThreads, [&](int, std::size_t begin, std::size_t end) {
+            for (std::size_t node = begin; node < end; node++) {
+                queued[node].store(0, std::memory_order_relaxed);
+            }
+        });
+        queued[startNode].store(1, std::memory_order_relaxed);
+
+        parallelForChunks(numReached, _numThreads, [&](int, std::size_t begin, std::size_t end) {
+            for (std::size_t rank = begin; rank < end; rank++) {
+                int node = order[rank];
+                for (int arc = _offsets[node]; arc < _offsets[node + 1]; arc++) {
+                    if (_weights[arc] > Weight{} &&
+                        Semiring::extend(distances[node], _weights[arc]) == distances[_targets[arc]]) {
+                        queued[_targets[arc]].store(1, std::memory_order_relaxed);
+                    }
+                }
+            }
+        });
+
+        std::priority_queue<int, std::vector<int>, std::greater<int>> heap;
+        for (int groupBegin = 0, groupEnd = 0; groupBegin < numReached; groupBegin = groupEnd) {
+            Weight distance = distances[order[groupBegin]];
+            while (groupEnd < numReached && distances[order[groupEnd]] == distance) {
+                groupEnd++;
+            }
+            if (groupEnd - groupBegin == 1) {
+                continue;
+            }
+
+            for (int i = groupBegin; i < groupEnd; i++) {
+                if (queued[order[i]].load(std::memory_order_relaxed)) {
+                    heap.push(order[i]);
+                }
+            }
+
+            // every node of the group ends at a queued one when following its zero-weight shortest arcs back
+            for (int i = groupBegin; !heap.empty(); i++) {
+                int node = heap.top();
+                heap.pop();
+                order[i] = node;
+
+                for (int arc = _offsets[node]; arc < _lightEnds[node]; arc++) {
+                    int target = _targets[arc];
+                    if (_weights[arc] == Weight{} && distances[target] == distance &&
+                        !queued[target].load(std::memory_order_relaxed)) {
+                        queued[target].store(1, std::memory_order_relaxed);
+                        heap.push(target);
+                    }
+                }
+            }
+        }
+    }
+
+    int _numNodes{};
+    Weight _delta{};
+    int _numThreads{};
+    int _minParallelFrontier{};
+    bool _hasZeroWeights = false;
+
+    // the graph's arcs, for every node the light ones in [offset, lightEnd)
+    std::vector<int> _offsets;
+    std::vector<int> _lightEnds;
+    std::vector<int> _targets;
+    std::vector<Weight> _weights;
+
+    std::unique_ptr<std::atomic<Weight>[]> _distances;
+    std::vector<std::vector<int>> _buckets;        // cyclic, bucket i holds distances in [i delta, (i + 1) delta)
+    std::vector<std::pair<int, long long>> _farNodes;   // (node, bucket) beyond the cyclic buckets
+    long long _bucketIndex{};                      // bucket being settled
+    std::vector<long long> _queuedBuckets;         // bucket a node is queued in, -1 if none
+    std::vector<long long> _settledBuckets;        // last bucket whose heavy arcs include the node
+    long long _numQueued{};                        // bucket entries, stale ones included
+
+    std::vector<int> _frontier;
+    std::vector<int> _settled;
+    std::vector<std::vector<int>> _chunkImproved;
+};
+
+// one-off run, delta 0 is chosen by chooseDeltaStepWidth
+template <typename Weight>
+int runDeltaStepping(const BasicCsrGraph<Weight>& graph, int startNode, std::vector<Weight>& distances,
+                     std::vector<int>& prevs, Weight delta = 0, int numThreads = getDefaultNumThreads()) {
+    return DeltaStepping<Weight>(graph, delta, numThreads).run(startNode, distances, prevs);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+
+#include "CsrGraph.h"
+#include "IndexedDaryHeap.h"
+#include "Semiring.h"
+
+// One-to-all Dijkstra over a CSR graph for a path semiring (Semiring.h).
+// Every node sits in the indexed heap at most once and is settled exactly
+// once, so the queue never grows beyond V and each relaxation is a
+// decrease-key. Extending a path must never make its label better - non-
+// negative weights for MinPlus, probabilities in [0, 1] for MaxTimes.
+// Unreachable nodes keep Semiring::zero() and prev -1.
+//
+// With a stopNode the search ends as soon as that node is settled: its
+// distance and the prevs on its path are final at that point (and the same as
+// in a full run), everything else may be partial. Returns the number of
+// settled nodes.
+template <typename Semiring, int Arity = 4>
+int runSemiringDijkstra(const BasicCsrGraph<typename Semiring::WeightType>& graph, int startNode,
+                        std::vector<typename Semiring::WeightType>& distances, std::vector<int>& prevs,
+                        int stopNode = -1) {
+    using Weight = typename Semiring::WeightType;
+
+    int numNodes = graph.getNumNodes();
+
+    distances.assign(numNodes, Semiring::zero());
+    prevs.assign(numNodes, -1);
+
+    IndexedDaryHeap<Weight, Arity, SemiringOrder<Semiring>> heap(numNodes);
+
+    distances[startNode] = Semiring::one();
+    heap.push(startNode, distances[startNode]);
+
+    int numSettled{};
+    while (!heap.empty()) {
+        int minNode = heap.pop();
+        Weight minDistance = distances[minNode];
+
+        numSettled++;
+        if (minNode == stopNode) {
+            break;
+        }
+
+        for (int arc = graph.getFirstArc(minNode); arc < graph.getLastArc(minNode); arc++) {
+            int child = graph.getTarget(arc);
+            Weight newDistance = Semiring::extend(minDistance, graph.getWeight(arc));
+
+            // settled nodes can not improve since extending a path never makes it better
+            if (Semiring::isBetter(newDistance, distances[child])) {
+                distances[child] = newDistance;
+                prevs[child] = minNode;
+                heap.pushOrDecrease(child, newDistance);
+            }
+        }
+    }
+
+    return numSettled;
+}
+
+// shortest paths with non-negative weights of any type, unreachable nodes
+// keep the largest Weight (+infinity for floating point)
+template <int Arity = 4, typename Weight>
+int runDijkstra(const BasicCsrGraph<Weight>& graph, int startNode, std::vector<Weight>& distances,
+                std::vector<int>& prevs, int stopNode = -1) {
+    return runSemiringDijkstra<MinPlus<Weight>, Arity>(graph, startNode, distances, prevs, stopNode);
+}
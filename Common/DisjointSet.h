@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+// Union-find over nodes [0, numNodes). Union by rank keeps every tree
+// O(log V) deep and findRoot halves the path it walks (every node is
+// re-linked to its grandparent), so a sequence of m operations costs
+// O(m * alpha(V)) - effectively linear.
+//
+// Parents are uint32_t and ranks a single byte (a rank never exceeds
+// log2(V) < 32), i.e. 5 bytes per node.
+class DisjointSet {
+public:
+    DisjointSet() = default;
+
+    explicit DisjointSet(int numNodes) : _parents(numNodes), _ranks(numNodes, 0), _numSets(numNodes) {
+        for (int node = 0; node < numNodes; node++) {
+            _parents[node] = static_cast<std::uint32_t>(node);
+        }
+    }
+
+    int findRoot(int node) {
+        std::uint32_t current = static_cast<std::uint32_t>(node);
+        while (_parents[current] != current) {
+            _parents[current] = _parents[_parents[current]];
+            current = _parents[current];
+        }
+        return static_cast<int>(current);
+    }
+
+    // merges the sets of both nodes, false when they already were in the same set
+    bool unite(int first, int second) {
+        int firstRoot = findRoot(first);
+        int secondRoot = findRoot(second);
+
+        if (firstRoot == secondRoot) {
+            return false;
+        }
+
+        if (_ranks[firstRoot] < _ranks[secondRoot]) {
+            std::swap(firstRoot, secondRoot);
+        }
+
+        _parents[secondRoot] = static_cast<std::uint32_t>(firstRoot);
+        if (_ranks[firstRoot] == _ranks[secondRoot]) {
+            _ranks[firstRoot]++;
+        }
+
+        _numSets--;
+        return true;
+    }
+
+    bool isConnected(int first, int second) { return findRoot(first) == findRoot(second); }
+
+    int getNumNodes() const { return static_cast<int>(_parents.size()); }
+    int getNumSets() const { return _numSets; }
+
+private:
+    std::vector<std::uint32_t> _parents;
+    std::vector<std::uint8_t> _ranks;
+    int _numSets{};
+};
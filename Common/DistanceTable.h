@@ -0,0 +1,274 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+
+#include "CsrGraph.h"
+#include "BinaryGraphFormat.h"
+#include "IndexedDaryHeap.h"
+#include "Parallel.h"
+#include "Semiring.h"
+
+// numRows x numColumns ints in one row-major block
+class DistanceMatrix {
+public:
+    DistanceMatrix() = default;
+
+    DistanceMatrix(int numRows, int numColumns, int value = std::numeric_limits<int>::max()) :
+        _numRows(numRows), _numColumns(numColumns),
+        _values(static_cast<std::size_t>(numRows) * numColumns, value) {}
+
+    int getNumRows() const { return _numRows; }
+    int getNumColumns() const { return _numColumns; }
+
+    int get(int row, int column) const { return _values[index(row, column)]; }
+    void set(int row, int column, int value) { _values[index(row, column)] = value; }
+
+    int* getRow(int row) { return _values.data() + index(row, 0); }
+    const int* getRow(int row) const { return _values.data() + index(row, 0); }
+
+private:
+    std::size_t index(int row, int column) const {
+        return static_cast<std::size_t>(row) * _numColumns + column;
+    }
+
+    int _numRows{};
+    int _numColumns{};
+    std::vector<int> _values;
+};
+
+// Dijkstra labels that are reset in O(1): a label only counts when its
+// version equals the current one, so starting a new search is one increment
+// instead of an O(V) fill. Version and distance share one 8-byte slot, so
+// reading a label is still a single cache access. One scratch per thread,
+// reused for every search.
+template <int Arity = 4>
+class DijkstraScratch {
+public:
+    explicit DijkstraScratch(int numNodes) : _labels(numNodes), _heap(numNodes) {}
+
+    void startSearch() {
+        _heap.clear();
+        if (++_currentVersion > std::numeric_limits<std::uint32_t>::max()) {
+            // after 2^32 searches the old versions could look current again
+            std::fill(_labels.begin(), _labels.end(), Label());
+            _currentVersion = 1;
+        }
+    }
+
+    int getDistance(int node) const {
+        const Label& label = _labels[node];
+        return label.version == _currentVersion ? label.distance : std::numeric_limits<int>::max();
+    }
+
+    void setDistance(int node, int distance) {
+        _labels[node] = { static_cast<std::uint32_t>(_currentVersion), distance };
+    }
+
+    IndexedDaryHeap<int, Arity>& getHeap() { return _heap; }
+
+private:
+    struct Label {
+        std::uint32_t version{};
+        int distance{};
+    };
+
+    std::vector<Label> _labels;
+    std::uint64_t _currentVersion{};   // wider than Label::version, so label stores can not alias it
+    IndexedDaryHeap<int, Arity> _heap;
+};
+
+// Runs one Dijkstra per source (non-negative weights) and calls
+// onRow(row, distances) with the distances from sources[row] to every
+// target, unreachable targets as std::numeric_limits<int>::max(). The
+// distances buffer belongs to the calling worker and is overwritten by its
+// next row, so onRow may modify it but has to copy what it keeps.
+//
+// Each search stops as soon as every target is settled. The sources are
+// handed out to numThreads workers through an atomic counter, so a few
+// expensive searches do not leave the other threads idle, and every worker
+// reuses a single DijkstraScratch for all of its searches. onRow is called
+// concurrently from different workers and rows arrive in no particular order.
+template <int Arity = 4, typename OnRow>
+void forEachDistanceRow(const CsrGraph& graph, const std::vector<int>& sources, const std::vector<int>& targets,
+                        int numThreads, OnRow onRow) {
+    int numNodes = graph.getNumNodes();
+    int numSources = static_cast<int>(sources.size());
+    int numTargets = static_cast<int>(targets.size());
+
+    // a target may be asked for more than once, the search waits for the distinct ones
+    std::vector<char> isTarget(numNodes, 0);
+    int numDistinctTargets{};
+    for (const int target : targets) {
+        if (!isTarget[target]) {
+            isTarget[target] = 1;
+            numDistinctTargets++;
+        }
+    }
+
+    std::atomic<int> nextSource{ 0 };
+
+    parallelForChunks(numSources, numThreads, [&](int, std::size_t, std::size_t) {
+        DijkstraScratch<Arity> scratch(numNodes);
+        IndexedDaryHeap<int, Arity>& heap = scratch.getHeap();
+        std::vector<int> distances(numTargets);
+
+        for (int row = nextSource++; row < numSources; row = nextSource++) {
+            scratch.startSearch();
+            scratch.setDistance(sources[row], 0);
+            heap.push(sources[row], 0);
+
+            int targetsLeft = numDistinctTargets;
+            while (!heap.empty() && targetsLeft > 0) {
+                int minNode = heap.pop();
+                int minDistance = scratch.getDistance(minNode);
+
+                if (isTarget[minNode]) {
+                    targetsLeft--;
+                }
+
+                for (int arc = graph.getFirstArc(minNode); arc < graph.getLastArc(minNode); arc++) {
+                    int child = graph.getTarget(arc);
+                    int newDistance = MinPlus<int>::extend(minDistance, graph.getWeight(arc));
+
+                    if (newDistance < scratch.getDistance(child)) {
+                        scratch.setDistance(child, newDistance);
+                        heap.pushOrDecrease(child, newDistance);
+                    }
+                }
+            }
+
+            for (int column = 0; column < numTargets; column++) {
+                distances[column] = scratch.getDistance(targets[column]);
+            }
+            onRow(row, distances.data());
+        }
+    });
+}
+
+// Distances from every source to every target (non-negative weights), row i
+// of the matrix belongs to sources[i], column j to targets[j]; unreachable
+// pairs keep std::numeric_limits<int>::max().
+template <int Arity = 4>
+DistanceMatrix computeDistanceTable(const CsrGraph& graph, const std::vector<int>& sources,
+                                    const std::vector<int>& targets, int numThreads = getDefaultNumThreads()) {
+    DistanceMatrix table(static_cast<int>(sources.size()), static_cast<int>(targets.size()));
+
+    forEachDistanceRow<Arity>(graph, sources, targets, numThreads, [&table](int row, const int* distances) {
+        std::copy(distances, distances + table.getNumColumns(), table.getRow(row));
+    });
+
+    return table;
+}
+
+// Distance matrix file (.dmat), little endian:
+//
+//   DistanceMatrixHeader (64 bytes)
+//   int32 distances[numRows][numColumns], row-major
+//
+// Every row has a fixed place in the file, so rows can be written in any
+// order while they are computed and the matrix never has to fit in memory.
+
+constexpr char DISTANCE_MATRIX_MAGIC[8] = { 'D', 'I', 'S', 'T', 'M', 'A', 'T', 'X' };
+constexpr std::uint32_t DISTANCE_MATRIX_VERSION = 1;
+
+struct DistanceMatrixHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::uint64_t numRows;
+    std::uint64_t numColumns;
+    std::uint64_t reserved[4];
+};
+
+static_assert(sizeof(DistanceMatrixHeader) == 64, "the header is part of the file format");
+
+// Writes the rows of a distance matrix file as they come, writeRow may be
+// called from several threads
+class DistanceMatrixWriter {
+public:
+    DistanceMatrixWriter(const std::string& path, int numRows, int numColumns) :
+        _path(path), _numColumns(numColumns), _out(path, std::ios::binary) {
+        if (!_out) {
+            throw std::runtime_error("Can not create " + path);
+        }
+
+        DistanceMatrixHeader header{};
+        std::memcpy(header.magic, DISTANCE_MATRIX_MAGIC, sizeof(header.magic));
+        header.version = DISTANCE_MATRIX_VERSION;
+        header.numRows = numRows;
+        header.numColumns = numColumns;
+
+        _out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    void writeRow(int row, const int* distances) {
+        std::size_t rowBytes = static_cast<std::size_t>(_numColumns) * sizeof(int);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _out.seekp(static_cast<std::streamoff>(sizeof(DistanceMatrixHeader) + row * rowBytes));
+        _out.write(reinterpret_cast<const char*>(distances), static_cast<std::streamsize>(rowBytes));
+    }
+
+    // flushes the file, throws when any write failed
+    void close() {
+        _out.close();
+        if (!_out) {
+            throw std::runtime_error("Can not write " + _path);
+        }
+    }
+
+private:
+    std::string _path;
+    int _numColumns{};
+    std::ofstream _out;
+    std::mutex _mutex;
+};
+
+// read-only distance matrix on a mapped .dmat file
+class MappedDistanceMatrix {
+public:
+    explicit MappedDistanceMatrix(const std::string& path) : _file(std::make_shared<MappedFile>(path)) {
+        DistanceMatrixHeader header{};
+        if (_file->getSize() < sizeof(header)) {
+            throw std::runtime_error(path + " is not a distance matrix file");
+        }
+        std::memcpy(&header, _file->getData(), sizeof(header));
+
+        if (std::memcmp(header.magic, DISTANCE_MATRIX_MAGIC, sizeof(header.magic)) != 0) {
+            throw std::runtime_error(path + " is not a distance matrix file");
+        }
+        if (header.version != DISTANCE_MATRIX_VERSION) {
+            throw std::runtime_error(path + " has unsupported format version " + std::to_string(header.version));
+        }
+        if (_file->getSize() < sizeof(header) + header.numRows * header.numColumns * sizeof(int)) {
+            throw std::runtime_error(path + " is truncated");
+        }
+
+        _numRows = static_cast<int>(header.numRows);
+        _numColumns = static_cast<int>(header.numColumns);
+        _values = reinterpret_cast<const int*>(_file->getData() + sizeof(header));
+    }
+
+    int getNumRows() const { return _numRows; }
+    int getNumColumns() const { return _numColumns; }
+
+    int get(int row, int column) const { return getRow(row)[column]; }
+    const int* getRow(int row) const { return _values + static_cast<std::size_t>(row) * _numColumns; }
+
+private:
+    std::shared_ptr<MappedFile> _file;
+    int _numRows{};
+    int _numColumns{};
+    const int* _values = nullptr;
+};
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include "CsrGraph.h"
+#include "DisjointSet.h"
+#include "Kruskal.h"
+#include "LinkCutTree.h"
+
+// Minimum spanning forest of a graph that changes by single edge insertions
+// and deletions, kept up to date instead of recomputed.
+//
+// Edges are ordered by (weight, id), so the forest is unique and equal to the
+// Kruskal forest of the live edges in id order. The forest lives in a
+// link-cut tree in which every edge is a vertex of its own (numNodes + id)
+// carrying its key, so the heaviest edge on a tree path is a path-max query.
+//
+//   addEdge      O(log V): a new edge joins the forest when it links two
+//                trees, or replaces the heaviest edge on the cycle it closes
+//                when it is lighter.
+//   removeEdge   O(1) for a non-forest edge. Cutting a forest edge splits a
+//                tree in two; both halves are explored in lockstep over
+//                forest edges until one is exhausted, then the non-forest
+//                edges of that smaller half are scanned for the lightest one
+//                leaving it - O(s log V + edges at the s nodes) for the
+//                smaller half of s nodes. That is sublinear when the cut
+//                edge is not central, but not polylog in the worst case
+//                (Holm et al. get there with O(log V) levels of forests).
+//
+// Ids of removed edges are reused by later insertions.
+template <typename Weight = int>
+class DynamicMinimumSpanningForest {
+public:
+    using Edge = BasicCsrEdge<Weight>;
+    using WeightSum = std::conditional_t<std::is_integral_v<Weight>, long long, Weight>;
+
+    // the initial forest comes from one Kruskal run, edge i gets id i
+    explicit DynamicMinimumSpanningForest(int numNodes, const std::vector<Edge>& edges = {}) :
+        _numNodes(numNodes), _incidentEdges(numNodes), _visitStamps(numNodes, 0) {
+        reserveIds(static_cast<int>(edges.size()));
+
+        for (const Edge& edge : edges) {
+            int id = allocateId(edge);
+            attach(id);
+        }
+
+        DisjointSet forest(numNodes);
+        runRadixSortKruskal(edges.size(), forest,
+            [&edges](std::size_t i) { return toRadixKey(edges[i].weight); },
+            [&edges](std::size_t i) { return std::make_pair(edges[i].from, edges[i].to); },
+            [this](std::size_t i) { linkEdge(static_cast<int>(i)); });
+    }
+
+    int getNumNodes() const { return _numNodes; }
+    int getNumEdges() const { return _numEdges; }
+    int getNumForestEdges() const { return _numForestEdges; }
+    WeightSum getTotalWeight() const { return _totalWeight; }
+
+    bool isAlive(int id) const { return id >= 0 && id < static_cast<int>(_edges.size()) && _alive[id]; }
+    bool isInForest(int id) const { return _inForest[id]; }
+    const Edge& getEdge(int id) const { return _edges[id]; }
+
+    bool isConnected(int first, int second) { return _tree.isConnected(first, second); }
+
+    // inserts the edge and returns its id
+    int addEdge(int from, int to, Weight weight) {
+        if (from < 0 || from >= _numNodes || to < 0 || to >= _numNodes) {
+            throw std::runtime_error("Edge (" + std::to_string(from) + ", " + std::to_string(to) +
+                                     ") has an end outside the graph");
+        }
+
+        int id = allocateId(Edge(from, to, weight));
+        attach(id);
+
+        if (from == to) {
+            return id;
+        }
+
+        if (!_tree.isConnected(from, to)) {
+            linkEdge(id);
+            return id;
+        }
+
+        int heaviest = _tree.findPathMax(from, to) - _numNodes;
+        if (getKey(id) < getKey(heaviest)) {
+            cutEdge(heaviest);
+            linkEdge(id);
+        }
+
+        return id;
+    }
+
+    void removeEdge(int id) {
+        if (!isAlive(id)) {
+            throw std::runtime_error("Edge " + std::to_string(id) + " is not in the graph");
+        }
+
+        detach(id);
+        _alive[id] = false;
+        _numEdges--;
+        _freeIds.push_back(id);
+
+        if (!_inForest[id]) {
+            return;
+        }
+
+        cutEdge(id);
+        _tree.clearKey(_numNodes + id);
+
+        int replacement = findReplacement(_edges[id].from, _edges[id].to);
+        if (replacement != -1) {
+            linkEdge(replacement);
+        }
+    }
+
+    std::vector<int> getForestEdgeIds() const {
+        std::vector<int> ids;
+        ids.reserve(_numForestEdges);
+        for (int id = 0; id < static_cast<int>(_edges.size()); id++) {
+            if (_alive[id] && _inForest[id]) {
+                ids.push_back(id);
+            }
+        }
+        return ids;
+    }
+
+    // forest edges in id order
+    std::vector<Edge> getForestEdges() const {
+        std::vector<Edge> forest;
+        forest.reserve(_numForestEdges);
+        for (const int id : getForestEdgeIds()) {
+            forest.push_back(_edges[id]);
+        }
+        return forest;
+    }
+
+private:
+    std::pair<Weight, int> getKey(int id) const { return { _edges[id].weight, id }; }
+
+    void reserveIds(int numIds) {
+        _edges.reserve(numIds);
+        _alive.reserve(numIds);
+        _inForest.reserve(numIds);
+        _incidentPositions.reserve(numIds);
+        _tree.resize(_numNodes + numIds);
+    }
+
+    int allocateId(const Edge& edge) {
+        int id;
+        if (!_freeIds.empty()) {
+            id = _freeIds.back();
+            _freeIds.pop_back();
+            _edges[id] = edge;
+        } else {
+            id = static_cast<int>(_edges.size());
+            _edges.push_back(edge);
+            _alive.push_back(false);
+            _inForest.push_back(false);
+            _incidentPositions.push_back({ -1, -1 });
+            if (_tree.getNumVertices() < _numNodes + id + 1) {
+                _tree.resize(std::max(_numNodes + id + 1, 2 * _tree.getNumVertices()));
+            }
+        }
+
+        _alive[id] = true;
+        _inForest[id] = false;
+        _numEdges++;
+        return id;
+    }
+
+    // the edge into the incidence lists of both ends, self-loops stay out
+    void attach(int id) {
+        const Edge& edge = _edges[id];
+        if (edge.from == edge.to) {
+            return;
+        }
+
+        _incidentPositions[id] = { static_cast<int>(_incidentEdges[edge.from].size()),
+                                   static_cast<int>(_incidentEdges[edge.to].size()) };
+        _incidentEdges[edge.from].push_back(id);
+        _incidentEdges[edge.to].push_back(id);
+    }
+
+    void detach(int id) {
+        const Edge& edge = _edges[id];
+        if (edge.from == edge.to) {
+            return;
+        }
+
+        removeIncident(edge.from, _incidentPositions[id][0]);
+        removeIncident(edge.to, _incidentPositions[id][1]);
+    }
+
+    // swap with the last entry and pop, the moved edge gets its new position
+    void removeIncident(int node, int position) {
+        std::vector<int>& incident = _incidentEdges[node];
+        int moved = incident.back();
+        incident[position] = moved;
+        _incidentPositions[moved][_edges[moved].from == node ? 0 : 1] = position;
+        incident.pop_back();
+    }
+
+    void linkEdge(int id) {
+        int vertex = _numNodes + id;
+        _tree.setKey(vertex, getKey(id));
+        _tree.link(_edges[id].from, vertex);
+        _tree.link(vertex, _edges[id].to);
+
+        _inForest[id] = true;
+        _numForestEdges++;
+        _totalWeight += _edges[id].weight;
+    }
+
+    void cutEdge(int id) {
+        int vertex = _numNodes + id;
+        _tree.cut(_edges[id].from, vertex);
+        _tree.cut(vertex, _edges[id].to);
+
+        _inForest[id] = false;
+        _numForestEdges--;
+        _totalWeight -= _edges[id].weight;
+    }
+
+    // Lightest live edge between the trees of first and second (just split
+    // apart), -1 when there is none. The two trees are explored one node at
+    // a time each, so the walk stops after about twice the smaller tree.
+    int findReplacement(int first, int second) {
+        std::array<unsigned, 2> stamps = { nextStamp(), nextStamp() };
+        std::array<std::vector<int>, 2> visited = { std::vector<int>{ first }, std::vector<int>{ second } };
+        std::array<std::size_t, 2> nextIndices = { 0, 0 };
+        _visitStamps[first] = stamps[0];
+        _visitStamps[second] = stamps[1];
+
+        int smaller = -1;
+        while (smaller == -1) {
+            for (int side = 0; side < 2 && smaller == -1; side++) {
+                if (nextIndices[side] == visited[side].size()) {
+                    smaller = side;
+                    break;
+                }
+
+                int node = visited[side][nextIndices[side]++];
+                for (const int id : _incidentEdges[node]) {
+                    if (!_inForest[id]) {
+                        continue;
+                    }
+                    int neighbour = _edges[id].from == node ? _edges[id].to : _edges[id].from;
+                    if (_visitStamps[neighbour] != stamps[side]) {
+                        _visitStamps[neighbour] = stamps[side];
+                        visited[side].push_back(neighbour);
+                    }
+                }
+            }
+        }
+
+        int best = -1;
+        for (const int node : visited[smaller]) {
+            for (const int id : _incidentEdges[node]) {
+                if (_inForest[id]) {
+                    continue;
+                }
+                int neighbour = _edges[id].from == node ? _edges[id].to : _edges[id].from;
+                if (_visitStamps[neighbour] != stamps[smaller] && (best == -1 || getKey(id) < getKey(best))) {
+                    best = id;
+                }
+            }
+        }
+
+        return best;
+    }
+
+    unsigned nextStamp() {
+        if (++_stamp == 0) {
+            std::fill(_visitStamps.begin(), _visitStamps.end(), 0);
+            _stamp = 1;
+        }
+        return _stamp;
+    }
+
+    int _numNodes{};
+    int _numEdges{};
+    int _numForestEdges{};
+    WeightSum _totalWeight{};
+
+    std::vector<Edge> _edges;
+    std::vector<bool> _alive;
+    std::vector<bool> _inForest;
+    std::vector<int> _freeIds;
+
+    std::vector<std::vector<int>> _incidentEdges;          // live non-loop edge ids per node
+    std::vector<std::array<int, 2>> _incidentPositions;    // slot of an edge in the lists of from and to
+
+    LinkCutTree<std::pair<Weight, int>> _tree;
+    std::vector<unsigned> _visitStamps;
+    unsigned _stamp{};
+};
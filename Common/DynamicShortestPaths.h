@@ -0,0 +1,223 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+
+#include "CsrGraph.h"
+#include "IndexedDaryHeap.h"
+#include "Semiring.h"
+
+// Single-source shortest paths that follow changes of edge weights instead of
+// being recomputed (Ramalingam-Reps). The graph structure is fixed, the
+// weights are kept per edge id here and can change between queries;
+// distances and prevs stay valid after every update.
+//
+// An update batch is repaired in two steps:
+//   1. increases - every node whose tree path runs over an edge that got
+//      heavier loses its distance. These are the subtrees below the increased
+//      tree edges. Each of them restarts with its cheapest in-arc from an
+//      unaffected node.
+//   2. decreases - an edge that got lighter offers its target a better
+//      distance.
+// One Dijkstra from the nodes touched this way finishes the repair; it only
+// gets past the changed region where distances really change, so an update
+// costs O((A + a) log A) for A changed nodes with a arcs - not O(V + E).
+//
+// Weights must be non-negative. Directed graphs need their reverse CSR (the
+// in-arcs of an invalidated node are scanned for its new parent). Unreachable
+// nodes keep MinPlus<Weight>::zero() and prev -1.
+template <int Arity = 4, typename Weight = int>
+class DynamicShortestPaths {
+public:
+    using Semiring = MinPlus<Weight>;
+
+    DynamicShortestPaths(const BasicCsrGraph<Weight>& graph, int startNode) :
+        _graph(graph), _startNode(startNode),
+        _weights(graph.getNumEdges()), _edgeEnds(graph.getNumEdges(), { -1, -1 }),
+        _distances(graph.getNumNodes(), Semiring::zero()), _prevs(graph.getNumNodes(), -1),
+        _prevEdges(graph.getNumNodes(), -1), _affected(graph.getNumNodes(), false), _heap(graph.getNumNodes()) {
+        if (!graph.isUndirected() && !graph.hasReverse()) {
+            throw std::runtime_error("A directed graph needs its reverse CSR for dynamic shortest paths");
+        }
+        if (startNode < 0 || startNode >= graph.getNumNodes()) {
+            throw std::runtime_error("Start node " + std::to_string(startNode) + " is not in the graph");
+        }
+
+        for (int node = 0; node < graph.getNumNodes(); node++) {
+            for (int arc = graph.getFirstArc(node); arc < graph.getLastArc(node); arc++) {
+                int id = graph.getEdgeId(arc);
+                if (_edgeEnds[id][0] == -1) {
+                    _edgeEnds[id] = { node, graph.getTarget(arc) };
+                    _weights[id] = checkWeight(graph.getWeight(arc));
+                }
+            }
+        }
+
+        _distances[startNode] = Semiring::one();
+        _heap.push(startNode, Semiring::one());
+        settle();
+        clearTouched();
+    }
+
+    int getStartNode() const { return _startNode; }
+    const std::vector<Weight>& getDistances() const { return _distances; }
+    const std::vector<int>& getPrevs() const { return _prevs; }
+    Weight getWeight(int edgeId) const { return _weights[edgeId]; }
+
+    // nodes whose distance was invalidated or improved by the last update
+    int getNumTouchedNodes() const { return _numTouchedNodes; }
+
+    void changeWeight(int edgeId, Weight weight) { changeWeights({ { edgeId, weight } }); }
+
+    // (edge id, new weight) pairs, repaired together; a batch with a bad
+    // entry throws before anything is changed
+    void changeWeights(const std::vector<std::pair<int, Weight>>& changes) {
+        for (const auto& [edgeId, weight] : changes) {
+            if (edgeId < 0 || edgeId >= static_cast<int>(_weights.size())) {
+                throw std::runtime_error("Edge " + std::to_string(edgeId) + " is not in the graph");
+            }
+            checkWeight(weight);
+        }
+
+        std::vector<Weight> oldWeights;
+        oldWeights.reserve(changes.size());
+        for (const auto& [edgeId, weight] : changes) {
+            oldWeights.push_back(_weights[edgeId]);
+            _weights[edgeId] = weight;
+        }
+
+        // 1. subtrees below heavier tree edges lose their distances
+        for (std::size_t i = 0; i < changes.size(); i++) {
+            int edgeId = changes[i].first;
+            if (_weights[edgeId] > oldWeights[i]) {
+                forEachDirection(edgeId, [&](int source, int target) {
+                    if (_prevEdges[target] == edgeId && _prevs[target] == source && !_affected[target]) {
+                        invalidateSubtree(target);
+                    }
+                });
+            }
+        }
+
+        for (const int node : _touched) {
+            reconnect(node);
+        }
+
+        // 2. lighter edges offer better distances
+        for (const auto& change : changes) {
+            forEachDirection(change.first, [&](int source, int target) {
+                relax(source, target, change.first);
+            });
+        }
+
+        settle();
+        _numTouchedNodes = static_cast<int>(_touched.size());
+        clearTouched();
+    }
+
+private:
+    static Weight checkWeight(Weight weight) {
+        if (weight < Weight{}) {
+            throw std::runtime_error("Dynamic shortest paths need non-negative weights");
+        }
+        return weight;
+    }
+
+    // calls visit(source, target) for the arc of a directed edge, for both arcs of an undirected one
+    template <typename Visit>
+    void forEachDirection(int edgeId, Visit visit) const {
+        auto [from, to] = _edgeEnds[edgeId];
+        visit(from, to);
+        if (_graph.isUndirected() && from != to) {
+            visit(to, from);
+        }
+    }
+
+    // root and every node below it in the shortest path tree, found over out-arcs
+    void invalidateSubtree(int root) {
+        std::size_t first = _touched.size();
+        _affected[root] = true;
+        _touched.push_back(root);
+
+        for (std::size_t i = first; i < _touched.size(); i++) {
+            int node = _touched[i];
+            for (int arc = _graph.getFirstArc(node); arc < _graph.getLastArc(node); arc++) {
+                int child = _graph.getTarget(arc);
+                if (!_affected[child] && _prevs[child] == node && _prevEdges[child] == _graph.getEdgeId(arc)) {
+                    _affected[child] = true;
+                    _touched.push_back(child);
+                }
+            }
+        }
+
+        for (std::size_t i = first; i < _touched.size(); i++) {
+            _distances[_touched[i]] = Semiring::zero();
+            _prevs[_touched[i]] = -1;
+            _prevEdges[_touched[i]] = -1;
+        }
+    }
+
+    // cheapest in-arc of an invalidated node from a node that kept its distance
+    void reconnect(int node) {
+        bool useOutArcs = _graph.isUndirected();
+        int first = useOutArcs ? _graph.getFirstArc(node) : _graph.getFirstInArc(node);
+        int last = useOutArcs ? _graph.getLastArc(node) : _graph.getLastInArc(node);
+
+        for (int arc = first; arc < last; arc++) {
+            int source = useOutArcs ? _graph.getTarget(arc) : _graph.getInSource(arc);
+            int edgeId = useOutArcs ? _graph.getEdgeId(arc) : _graph.getInEdgeId(arc);
+            if (!_affected[source]) {
+                relax(source, node, edgeId);
+            }
+        }
+    }
+
+    void relax(int source, int target, int edgeId) {
+        Weight newDistance = Semiring::extend(_distances[source], _weights[edgeId]);
+        if (Semiring::isBetter(newDistance, _distances[target])) {
+            if (!_affected[target]) {
+                _affected[target] = true;
+                _touched.push_back(target);
+            }
+            _distances[target] = newDistance;
+            _prevs[target] = source;
+            _prevEdges[target] = edgeId;
+            _heap.pushOrDecrease(target, newDistance);
+        }
+    }
+
+    // Dijkstra from the queued nodes
+    void settle() {
+        while (!_heap.empty()) {
+            int minNode = _heap.pop();
+
+            for (int arc = _graph.getFirstArc(minNode); arc < _graph.getLastArc(minNode); arc++) {
+                relax(minNode, _graph.getTarget(arc), _graph.getEdgeId(arc));
+            }
+        }
+    }
+
+    void clearTouched() {
+        for (const int node : _touched) {
+            _affected[node] = false;
+        }
+        _touched.clear();
+    }
+
+    const BasicCsrGraph<Weight>& _graph;
+    int _startNode{};
+
+    std::vector<Weight> _weights;                  // current weight per edge id
+    std::vector<std::array<int, 2>> _edgeEnds;     // (from, to) per edge id
+
+    std::vector<Weight> _distances;
+    std::vector<int> _prevs;
+    std::vector<int> _prevEdges;                   // edge id of the tree arc into a node
+
+    std::vector<bool> _affected;                   // invalidated or improved by the running update
+    std::vector<int> _touched;
+    IndexedDaryHeap<Weight, Arity> _heap;
+    int _numTouchedNodes{};
+};
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "CsrGraph.h"
+
+// Reads stdin or a file in 1 MiB blocks and scans integers straight out of the
+// block, so parsing an edge costs no allocation, no locale lookup and no
+// istringstream. readInt() skips everything that is not part of a number,
+// which lets the same scanner read "src dest weight", "from - to - weight",
+// "Nodes: 9" or "Path: 0 - 6" lines - a '-' only starts a number when a digit
+// follows it directly. readDouble() reads decimals such as "0.975" or "1e-3"
+// the same way.
+class FastInputReader {
+public:
+    static constexpr std::size_t BLOCK_SIZE = 1 << 20;
+
+    explicit FastInputReader(std::FILE* file = stdin) : _file(file), _buffer(BLOCK_SIZE) {}
+
+    explicit FastInputReader(const std::string& path) : _buffer(BLOCK_SIZE) {
+        _file = std::fopen(path.c_str(), "rb");
+        if (_file == nullptr) {
+            throw std::runtime_error("Can not open " + path);
+        }
+        _ownsFile = true;
+    }
+
+    FastInputReader(const FastInputReader&) = delete;
+    FastInputReader& operator=(const FastInputReader&) = delete;
+
+    ~FastInputReader() {
+        if (_ownsFile) {
+            std::fclose(_file);
+        }
+    }
+
+    // next integer in the input, 0 at end of input
+    int readInt() {
+        int ch = peek();
+        while (ch != EOF && !isDigit(ch) && !(ch == '-' && isDigit(peekNext()))) {
+            advance();
+            ch = peek();
+        }
+
+        if (ch == EOF) {
+            return 0;
+        }
+
+        bool negative = ch == '-';
+        if (negative) {
+            advance();
+        }
+
+        int value{};
+        for (ch = peek(); isDigit(ch); ch = peek()) {
+            value = value * 10 + (ch - '0');
+            advance();
+        }
+
+        return negative ? -value : value;
+    }
+
+    // next decimal number in the input (optional sign, fraction and exponent), 0 at end of input;
+    // a number starts at a digit, at '.' or '-' before a digit, or at "-." before a digit
+    double readDouble() {
+        int ch = peek();
+        while (ch != EOF && !isDigit(ch) && !startsSignedDecimal(ch)) {
+            advance();
+            ch = peek();
+        }
+
+        if (ch == EOF) {
+            return 0.0;
+        }
+
+        // the token is copied into a small buffer so that strtod parses it exactly
+        char token[64];
+        std::size_t length{};
+        auto take = [&]() {
+            if (length + 1 < sizeof(token)) {
+                token[length++] = static_cast<char>(peek());
+            }
+            advance();
+        };
+
+        if (peek() == '-') {
+            take();
+        }
+        while (isDigit(peek())) {
+            take();
+        }
+        if (peek() == '.') {
+            take();
+            while (isDigit(peek())) {
+                take();
+            }
+        }
+        if (peek() == 'e' || peek() == 'E') {
+            take();
+            if (peek() == '-' || peek() == '+') {
+                take();
+            }
+            while (isDigit(peek())) {
+                take();
+            }
+        }
+
+        token[length] = '\0';
+        return std::strtod(token, nullptr);
+    }
+
+    // from, to and weight - any separators between them are skipped
+    CsrEdge readEdge() {
+        int from = readInt();
+        int to = readInt();
+        int weight = readInt();
+        return CsrEdge(from, to, weight);
+    }
+
+    std::vector<CsrEdge> readEdges(int numEdges) {
+        std::vector<CsrEdge> edges;
+        edges.reserve(numEdges);
+
+        for (int i = 0; i < numEdges; i++) {
+            edges.push_back(readEdge());
+        }
+
+        return edges;
+    }
+
+    // true when something other than blanks is left before the end of the current line
+    bool hasTokenOnLine() {
+        int ch = peek();
+        while (ch == ' ' || ch == '\t' || ch == '\r') {
+            advance();
+            ch = peek();
+        }
+        return ch != '\n' && ch != EOF;
+    }
+
+    // consumes the rest of the current line including the line break
+    void skipLine() {
+        int ch = peek();
+        while (ch != '\n' && ch != EOF) {
+            advance();
+            ch = peek();
+        }
+        if (ch == '\n') {
+            advance();
+        }
+    }
+
+    bool isEof() { return peek() == EOF; }
+
+    std::size_t getBytesRead() const { return _bytesBefore + _pos; }
+
+private:
+    static bool isDigit(int ch) { return ch >= '0' && ch <= '9'; }
+
+    int peek() {
+        if (_pos == _size && !refill()) {
+            return EOF;
+        }
+        return static_cast<unsigned char>(_buffer[_pos]);
+    }
+
+    // character offset places after the current one, may pull in the next block
+    int peekNext(std::size_t offset = 1) {
+        if (_pos + offset >= _size) {
+            keepTail();
+            if (_pos + offset >= _size) {
+                return EOF;
+            }
+        }
+        return static_cast<unsigned char>(_buffer[_pos + offset]);
+    }
+
+    // '.' or '-' directly before a digit, or "-." before one
+    bool startsSignedDecimal(int ch) {
+        if (ch == '.') {
+            return isDigit(peekNext());
+        }
+        return ch == '-' && (isDigit(peekNext()) || (peekNext() == '.' && isDigit(peekNext(2))));
+    }
+
+    void advance() { _pos++; }
+
+    bool refill() {
+        _bytesBefore += _size;
+        _pos = 0;
+        _size = std::fread(_buffer.data(), 1, _buffer.size(), _file);
+        return _size > 0;
+    }
+
+    // moves the unread tail to the front of the buffer and appends the next block behind it
+    void keepTail() {
+        std::size_t tail = _size - _pos;
+        for (std::size_t i = 0; i < tail; i++) {
+            _buffer[i] = _buffer[_pos + i];
+        }
+        _bytesBefore += _pos;
+        _pos = 0;
+        _size = tail + std::fread(_buffer.data() + tail, 1, _buffer.size() - tail, _file);
+    }
+
+    std::FILE* _file = nullptr;
+    bool _ownsFile = false;
+
+    std::vector<char> _buffer;
+    std::size_t _pos{};
+    std::size_t _size{};
+    std::size_t _bytesBefore{};
+};
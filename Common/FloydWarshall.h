@@ -0,0 +1,225 @@
+#pragma once
+
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define FLOYD_WARSHALL_HAS_AVX2 1
+#endif
+
+#include "CsrGraph.h"
+#include "DistanceTable.h"
+#include "Parallel.h"
+#include "Semiring.h"
+
+enum class FloydWarshallKernel {
+    Auto,    // AVX2 when the CPU supports it, scalar otherwise
+    Scalar,
+    Avx2     // throws when the CPU (or the compiler) does not support it
+};
+
+struct FloydWarshallResult {
+    bool hasNegativeCycle = false;
+    int negativeCycleNode = -1;   // a node with a negative distance to itself
+};
+
+// Dense distance matrix of a graph: the cheapest arc u -> v, 0 on the
+// diagonal unless a self loop is negative, std::numeric_limits<int>::max()
+// where there is no arc.
+inline DistanceMatrix buildArcDistances(const CsrGraph& graph) {
+    int numNodes = graph.getNumNodes();
+    DistanceMatrix distances(numNodes, numNodes);
+
+    for (int node = 0; node < numNodes; node++) {
+        distances.set(node, node, 0);
+    }
+    for (int node = 0; node < numNodes; node++) {
+        for (int arc = graph.getFirstArc(node); arc < graph.getLastArc(node); arc++) {
+            int to = graph.getTarget(arc);
+            distances.set(node, to, std::min(distances.get(node, to), graph.getWeight(arc)));
+        }
+    }
+
+    return distances;
+}
+
+namespace FloydWarshallDetail {
+
+constexpr int INF = std::numeric_limits<int>::max();
+
+// 64 x 64 ints = 16 KB per tile, the three tiles of an update fit in L1 / L2
+constexpr int TILE_SIZE = 64;
+
+// Min-plus update of one tile: for every k of the pivot block,
+// c[i][j] = min(c[i][j], a[i][k] + b[k][j]). a, b and c point at the top
+// left corner of their tile in a matrix with rowStride ints per row and may
+// be the same tile. INF is absorbing - INF + w stays INF for any w, also a
+// negative one - so the sentinel never turns into a distance. A finite sum
+// outside the int range saturates (MinPlus<int>::extend) instead of wrapping.
+inline void updateTileScalar(int* c, const int* a, const int* b, std::size_t rowStride) {
+    for (int k = 0; k < TILE_SIZE; k++) {
+        const int* bRow = b + k * rowStride;
+        for (int i = 0; i < TILE_SIZE; i++) {
+            int aik = a[i * rowStride + k];
+            if (aik == INF) {
+                continue;
+            }
+
+            int* cRow = c + i * rowStride;
+            for (int j = 0; j < TILE_SIZE; j++) {
+                int candidate = MinPlus<int>::extend(bRow[j], aik);
+                cRow[j] = std::min(cRow[j], candidate);
+            }
+        }
+    }
+}
+
+#ifdef FLOYD_WARSHALL_HAS_AVX2
+// the same update 8 columns at a time; only compiled for AVX2, called after a runtime check
+__attribute__((target("avx2")))
+inline void updateTileAvx2(int* c, const int* a, const int* b, std::size_t rowStride) {
+    constexpr int LOWEST = std::numeric_limits<int>::lowest();
+    const __m256i inf = _mm256_set1_epi32(INF);
+    const __m256i lowest = _mm256_set1_epi32(LOWEST);
+
+    for (int k = 0; k < TILE_SIZE; k++) {
+        const int* bRow = b + k * rowStride;
+        for (int i = 0; i < TILE_SIZE; i++) {
+            int aik = a[i * rowStride + k];
+            if (aik == INF) {
+                continue;
+            }
+
+            // aik + bkj saturates to INF above bkj > INF - aik, to LOWEST below bkj < LOWEST - aik
+            const __m256i aikVector = _mm256_set1_epi32(aik);
+            const __m256i upperLimit = _mm256_set1_epi32(aik > 0 ? INF - aik : INF);
+            const __m256i lowerLimit = _mm256_set1_epi32(aik < 0 ? LOWEST - aik : LOWEST);
+            int* cRow = c + i * rowStride;
+            for (int j = 0; j < TILE_SIZE; j += 8) {
+                __m256i bkj = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bRow + j));
+                __m256i candidate = _mm256_add_epi32(aikVector, bkj);
+                __m256i above = _mm256_or_si256(_mm256_cmpgt_epi32(bkj, upperLimit), _mm256_cmpeq_epi32(bkj, inf));
+                candidate = _mm256_blendv_epi8(candidate, lowest, _mm256_cmpgt_epi32(lowerLimit, bkj));
+                candidate = _mm256_blendv_epi8(candidate, inf, above);
+
+                __m256i cij = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cRow + j));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(cRow + j), _mm256_min_epi32(cij, candidate));
+            }
+        }
+    }
+}
+#endif
+
+inline bool cpuSupportsAvx2() {
+#ifdef FLOYD_WARSHALL_HAS_AVX2
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+} // namespace FloydWarshallDetail
+
+// All-pairs shortest paths in place on a dense V x V matrix (see
+// buildArcDistances), negative weights allowed; path lengths outside the int
+// range saturate like MinPlus<int>.
+//
+// Blocked Floyd-Warshall: the matrix is cut into 64 x 64 tiles and every
+// round of 64 pivots updates (1) the diagonal tile with itself, (2) the
+// other tiles of the pivot row and column from the diagonal tile, (3) all
+// remaining tiles from their pivot row and column tiles. The tiles of phase
+// 2 and of phase 3 are independent of each other and run on numThreads
+// threads. Rows are padded to whole tiles with INF in a working copy.
+//
+// A negative entry on the diagonal after a round is a negative cycle: the
+// run stops there (distances are not final then) so that the distances
+// around the cycle can not keep falling and overflow.
+inline FloydWarshallResult runFloydWarshall(DistanceMatrix& distances, int numThreads = getDefaultNumThreads(),
+                                            FloydWarshallKernel kernel = FloydWarshallKernel::Auto) {
+    using namespace FloydWarshallDetail;
+
+    if (distances.getNumRows() != distances.getNumColumns()) {
+        throw std::runtime_error("Floyd-Warshall needs a square distance matrix");
+    }
+    if (kernel == FloydWarshallKernel::Avx2 && !cpuSupportsAvx2()) {
+        throw std::runtime_error("The AVX2 Floyd-Warshall kernel is not supported on this machine");
+    }
+
+    bool useAvx2 = kernel != FloydWarshallKernel::Scalar && cpuSupportsAvx2();
+    auto updateTile = [useAvx2](int* c, const int* a, const int* b, std::size_t rowStride) {
+#ifdef FLOYD_WARSHALL_HAS_AVX2
+        if (useAvx2) {
+            updateTileAvx2(c, a, b, rowStride);
+            return;
+        }
+#endif
+        updateTileScalar(c, a, b, rowStride);
+    };
+
+    int numNodes = distances.getNumRows();
+    int numTiles = (numNodes + TILE_SIZE - 1) / TILE_SIZE;
+    std::size_t stride = static_cast<std::size_t>(numTiles) * TILE_SIZE;
+
+    std::vector<int> matrix(stride * stride, INF);
+    for (int row = 0; row < numNodes; row++) {
+        std::copy(distances.getRow(row), distances.getRow(row) + numNodes, matrix.data() + row * stride);
+    }
+
+    auto tile = [&matrix, stride](int tileRow, int tileColumn) {
+        return matrix.data() + static_cast<std::size_t>(tileRow) * TILE_SIZE * stride +
+               static_cast<std::size_t>(tileColumn) * TILE_SIZE;
+    };
+
+    FloydWarshallResult result;
+
+    for (int pivot = 0; pivot < numTiles && !result.hasNegativeCycle; pivot++) {
+        int* pivotTile = tile(pivot, pivot);
+        updateTile(pivotTile, pivotTile, pivotTile, stride);
+
+        // phase 2: tile i < numTiles - 1 is the i-th other tile of the pivot row, the rest the pivot column
+        parallelForChunks(2 * (numTiles - 1), numThreads, [&](int, std::size_t begin, std::size_t end) {
+            for (std::size_t index = begin; index < end; index++) {
+                int other = static_cast<int>(index % (numTiles - 1));
+                other += other >= pivot ? 1 : 0;
+
+                if (static_cast<int>(index) < numTiles - 1) {
+                    int* rowTile = tile(pivot, other);
+                    updateTile(rowTile, pivotTile, rowTile, stride);
+                } else {
+                    int* columnTile = tile(other, pivot);
+                    updateTile(columnTile, columnTile, pivotTile, stride);
+                }
+            }
+        });
+
+        // phase 3: every tile off the pivot row and column, row-major over the (numTiles - 1)^2 of them
+        parallelForChunks((numTiles - 1) * (numTiles - 1), numThreads, [&](int, std::size_t begin, std::size_t end) {
+            for (std::size_t index = begin; index < end; index++) {
+                int tileRow = static_cast<int>(index / (numTiles - 1));
+                int tileColumn = static_cast<int>(index % (numTiles - 1));
+                tileRow += tileRow >= pivot ? 1 : 0;
+                tileColumn += tileColumn >= pivot ? 1 : 0;
+
+                updateTile(tile(tileRow, tileColumn), tile(tileRow, pivot), tile(pivot, tileColumn), stride);
+            }
+        });
+
+        for (int node = 0; node < numNodes; node++) {
+            if (matrix[node * stride + node] < 0) {
+                result.hasNegativeCycle = true;
+                result.negativeCycleNode = node;
+                break;
+            }
+        }
+    }
+
+    for (int row = 0; row < numNodes; row++) {
+        std::copy(matrix.data() + row * stride, matrix.data() + row * stride + numNodes, distances.getRow(row));
+    }
+
+    return result;
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <utility>
+
+// Min-heap (with respect to Compare) of node ids in [0, capacity) keyed by
+// Key. Every node is stored at most once and _positions maps a node to its
+// slot, so the key of a queued node can be improved in place in
+// O(log_d V) instead of pushing a duplicate. Nodes with equal keys leave the
+// heap in ascending id order, which keeps the pop order deterministic.
+//
+// Arity is fixed at compile time - 4 is usually the sweet spot, since the
+// children of a slot share one cache line and the tree is half as deep.
+template <typename Key, int Arity = 4, typename Compare = std::less<Key>>
+class IndexedDaryHeap {
+    static_assert(Arity >= 2, "heap arity must be at least 2");
+
+public:
+    static constexpr int NOT_IN_HEAP = -1;
+
+    IndexedDaryHeap() = default;
+
+    explicit IndexedDaryHeap(int capacity, Compare compare = Compare()) :
+        _positions(capacity, NOT_IN_HEAP), _compare(compare) {}
+
+    // grows the id range, queued nodes are kept
+    void reserve(int capacity) {
+        if (capacity > static_cast<int>(_positions.size())) {
+            _positions.resize(capacity, NOT_IN_HEAP);
+        }
+    }
+
+    bool empty() const { return _nodes.empty(); }
+    int size() const { return static_cast<int>(_nodes.size()); }
+    int capacity() const { return static_cast<int>(_positions.size()); }
+
+    bool contains(int node) const { return _positions[node] != NOT_IN_HEAP; }
+
+    int top() const { return _nodes.front(); }
+    const Key& topKey() const { return _keys.front(); }
+    const Key& getKey(int node) const { return _keys[_positions[node]]; }
+
+    void push(int node, const Key& key) {
+        _nodes.push_back(node);
+        _keys.push_back(key);
+        _positions[node] = size() - 1;
+        siftUp(size() - 1);
+    }
+
+    // key must not be worse than the current one
+    void decreaseKey(int node, const Key& key) {
+        int slot = _positions[node];
+        _keys[slot] = key;
+        siftUp(slot);
+    }
+
+    // sets any key, better or worse
+    void updateKey(int node, const Key& key) {
+        int slot = _positions[node];
+        bool isBetter = _compare(key, _keys[slot]);
+        _keys[slot] = key;
+        if (isBetter) {
+            siftUp(slot);
+        } else {
+            siftDown(slot);
+        }
+    }
+
+    // inserts the node or improves its key, returns false when the queued key is already better
+    bool pushOrDecrease(int node, const Key& key) {
+        if (!contains(node)) {
+            push(node, key);
+            return true;
+        }
+
+        if (_compare(key, getKey(node))) {
+            decreaseKey(node, key);
+            return true;
+        }
+
+        return false;
+    }
+
+    int pop() {
+        int node = _nodes.front();
+        _positions[node] = NOT_IN_HEAP;
+
+        int last = size() - 1;
+        if (last > 0) {
+            moveSlot(last, 0);
+        }
+        _nodes.pop_back();
+        _keys.pop_back();
+
+        if (last > 0) {
+            siftDown(0);
+        }
+
+        return node;
+    }
+
+    // O(size) - only the queued nodes are touched
+    void clear() {
+        for (const int node : _nodes) {
+            _positions[node] = NOT_IN_HEAP;
+        }
+        _nodes.clear();
+        _keys.clear();
+    }
+
+private:
+    // strict weak order on (key, node id)
+    bool precedes(const Key& key, int node, const Key& otherKey, int otherNode) const {
+        if (_compare(key, otherKey)) {
+            return true;
+        }
+        return !_compare(otherKey, key) && node < otherNode;
+    }
+
+    void moveSlot(int from, int to) {
+        _nodes[to] = _nodes[from];
+        _keys[to] = std::move(_keys[from]);
+        _positions[_nodes[to]] = to;
+    }
+
+    void siftUp(int slot) {
+        int node = _nodes[slot];
+        Key key = std::move(_keys[slot]);
+
+        while (slot > 0) {
+            int parent = (slot - 1) / Arity;
+            if (!precedes(key, node, _keys[parent], _nodes[parent])) {
+                break;
+            }
+            moveSlot(parent, slot);
+            slot = parent;
+        }
+
+        _nodes[slot] = node;
+        _keys[slot] = std::move(key);
+        _positions[node] = slot;
+    }
+
+    void siftDown(int slot) {
+        int node = _nodes[slot];
+        Key key = std::move(_keys[slot]);
+        int heapSize = size();
+
+        while (true) {
+            int firstChild = slot * Arity + 1;
+            if (firstChild >= heapSize) {
+                break;
+            }
+
+            int lastChild = std::min(firstChild + Arity, heapSize);
+            int bestChild = firstChild;
+            for (int child = firstChild + 1; child < lastChild; child++) {
+                if (precedes(_keys[child], _nodes[child], _keys[bestChild], _nodes[bestChild])) {
+                    bestChild = child;
+                }
+            }
+
+            if (!precedes(_keys[bestChild], _nodes[bestChild], key, node)) {
+                break;
+            }
+
+            moveSlot(bestChild, slot);
+            slot = bestChild;
+        }
+
+        _nodes[slot] = node;
+        _keys[slot] = std::move(key);
+        _positions[node] = slot;
+    }
+
+    std::vector<int> _nodes;
+    std::vector<Key> _keys;
+    std::vector<int> _positions;
+    Compare _compare;
+};
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <algorithm>
+
+#include "CsrGraph.h"
+#include "BellmanFord.h"
+#include "DistanceTable.h"
+#include "Parallel.h"
+
+// All-pairs shortest paths on sparse graphs with negative arc weights
+// (Johnson's algorithm): one Bellman-Ford run for node potentials h, then
+// every arc (u, v, w) is reweighted to w + h(u) - h(v) >= 0 and V Dijkstra
+// searches run on the reweighted graph. A reweighted distance d' maps back to
+// d(u, v) = d'(u, v) - h(u) + h(v). O(VE log V) instead of the O(V^3) of
+// Floyd-Warshall, and the Dijkstra searches are independent of each other.
+
+// Potentials from a virtual source with a zero-weight arc to every node,
+// i.e. h(v) = min(0, shortest distance to v from anywhere). The virtual
+// source has no incoming arcs, so a negative cycle of the Bellman-Ford run
+// is a negative cycle of graph itself.
+inline BellmanFordResult computeJohnsonPotentials(const CsrGraph& graph, std::vector<int>& potentials,
+                                                  BellmanFordMode mode = BellmanFordMode::Queue,
+                                                  int numThreads = getDefaultNumThreads()) {
+    int numNodes = graph.getNumNodes();
+
+    std::vector<CsrEdge> edges;
+    edges.reserve(static_cast<std::size_t>(graph.getNumArcs()) + numNodes);
+    for (int node = 0; node < numNodes; node++) {
+        for (int arc = graph.getFirstArc(node); arc < graph.getLastArc(node); arc++) {
+            edges.emplace_back(node, graph.getTarget(arc), graph.getWeight(arc));
+        }
+    }
+    for (int node = 0; node < numNodes; node++) {
+        edges.emplace_back(numNodes, node, 0);
+    }
+
+    CsrGraph augmented(numNodes + 1, edges);
+
+    std::vector<int> prevs;
+    BellmanFordResult result = runBellmanFord(augmented, numNodes, potentials, prevs, mode, numThreads);
+    potentials.resize(numNodes);
+
+    return result;
+}
+
+// Directed copy of graph with every arc reweighted to w + h(u) - h(v), arcs
+// keep their CSR order. Throws when a reweighted arc does not fit in an int.
+inline CsrGraph reweightByPotentials(const CsrGraph& graph, const std::vector<int>& potentials) {
+    std::vector<CsrEdge> edges;
+    edges.reserve(graph.getNumArcs());
+
+    for (int node = 0; node < graph.getNumNodes(); node++) {
+        for (int arc = graph.getFirstArc(node); arc < graph.getLastArc(node); arc++) {
+            int to = graph.getTarget(arc);
+            long long weight = static_cast<long long>(graph.getWeight(arc)) + potentials[node] - potentials[to];
+            if (weight > std::numeric_limits<int>::max()) {
+                throw std::runtime_error("Reweighted arc " + std::to_string(node) + " -> " + std::to_string(to) +
+                                         " does not fit in an int");
+            }
+            edges.emplace_back(node, to, static_cast<int>(weight));
+        }
+    }
+
+    return CsrGraph(graph.getNumNodes(), edges);
+}
+
+// Distances of Johnson's algorithm for potentials from
+// computeJohnsonPotentials (no negative cycle), handed to
+// onRow(row, distances) instead of being collected: the distances from node
+// row to every node, unreachable nodes as std::numeric_limits<int>::max().
+// onRow runs concurrently on numThreads workers, in no particular row order
+// (see forEachDistanceRow).
+template <typename OnRow>
+void forEachAllPairsRow(const CsrGraph& graph, const std::vector<int>& potentials, int numThreads, OnRow onRow) {
+    const int INF = std::numeric_limits<int>::max();
+
+    CsrGraph reweighted = reweightByPotentials(graph, potentials);
+
+    std::vector<int> nodes(graph.getNumNodes());
+    std::iota(nodes.begin(), nodes.end(), 0);
+
+    forEachDistanceRow(reweighted, nodes, nodes, numThreads, [&](int row, int* distances) {
+        for (std::size_t node = 0; node < nodes.size(); node++) {
+            if (distances[node] != INF) {
+                // d'(u, v) - h(u) + h(v) in long long - a saturated potential can push even the difference
+                // out of the int range - clamped back like MinPlus<int>
+                long long distance = static_cast<long long>(distances[node]) + potentials[node] - potentials[row];
+                distances[node] = static_cast<int>(
+                    std::clamp<long long>(distance, std::numeric_limits<int>::lowest(), INF));
+            }
+        }
+        onRow(row, static_cast<const int*>(distances));
+    });
+}
+
+// V x V matrix of shortest distances, row = source, column = target. A
+// negative cycle is reported in the result and distances is left empty.
+inline BellmanFordResult computeAllPairsDistances(const CsrGraph& graph, DistanceMatrix& distances,
+                                                  int numThreads = getDefaultNumThreads()) {
+    int numNodes = graph.getNumNodes();
+    distances = DistanceMatrix();
+
+    std::vector<int> potentials;
+    BellmanFordResult result = computeJohnsonPotentials(graph, potentials, BellmanFordMode::Queue, numThreads);
+    if (result.hasNegativeCycle) {
+        return result;
+    }
+
+    distances = DistanceMatrix(numNodes, numNodes);
+    forEachAllPairsRow(graph, potentials, numThreads, [&distances, numNodes](int row, const int* rowDistances) {
+        std::copy(rowDistances, rowDistances + numNodes, distances.getRow(row));
+    });
+
+    return result;
+}
+
+// The same matrix streamed row by row into a distance matrix file (see
+// DistanceMatrixWriter), for graphs whose V^2 distances do not fit in
+// memory: only one row per thread is held at a time. No file is written when
+// the graph has a negative cycle.
+inline BellmanFordResult saveAllPairsDistances(const CsrGraph& graph, const std::string& path,
+                                               int numThreads = getDefaultNumThreads()) {
+    int numNodes = graph.getNumNodes();
+
+    std::vector<int> potentials;
+    BellmanFordResult result = computeJohnsonPotentials(graph, potentials, BellmanFordMode::Queue, numThreads);
+    if (result.hasNegativeCycle) {
+        return result;
+    }
+
+    DistanceMatrixWriter writer(path, numNodes, numNodes);
+    forEachAllPairsRow(graph, potentials, numThreads, [&writer](int row, const int* rowDistances) {
+        writer.writeRow(row, rowDistances);
+    });
+    writer.close();
+
+    return result;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "DisjointSet.h"
+#include "RadixSort.h"
+#include "Parallel.h"
+
+enum class KruskalMode {
+    Heap,       // edges popped one by one from a priority queue
+    RadixSort   // edges radix sorted once, then streamed through union-find
+};
+
+// Kruskal over an edge array sorted once by getKey(edgeIndex) - the order of
+// the accepted edges is ascending key, ties in input order. getEnds(edgeIndex)
+// returns the (source, dest) pair and visit(edgeIndex) is called for every
+// edge that joins two sets of forest. The scan stops as soon as everything is
+// one set (V - 1 edges accepted on a fresh forest), because the tree can not
+// grow any further. Returns the number of accepted edges.
+template <typename GetKey, typename GetEnds, typename Visit>
+int runRadixSortKruskal(std::size_t numEdges, DisjointSet& forest, GetKey getKey, GetEnds getEnds, Visit visit,
+                        int numThreads = getDefaultNumThreads()) {
+    std::vector<std::uint32_t> order = radixSortIndicesByKey(numEdges, getKey, numThreads);
+
+    int accepted{};
+
+    for (std::size_t i = 0; i < numEdges && forest.getNumSets() > 1; i++) {
+        std::uint32_t edgeIndex = order[i];
+        auto [source, dest] = getEnds(edgeIndex);
+
+        if (forest.unite(source, dest)) {
+            visit(edgeIndex);
+            accepted++;
+        }
+    }
+
+    return accepted;
+}
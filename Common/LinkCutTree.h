@@ -0,0 +1,194 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <utility>
+
+// Link-cut tree (Sleator-Tarjan) over vertices [0, numVertices) with a
+// path-maximum query. Every vertex may carry a Key; findPathMax(u, v)
+// returns the vertex with the largest key on the tree path between u and v.
+// The represented forest is unrooted: link and cut re-root internally.
+//
+// Each preferred path is a splay tree ordered by depth, _pathMax caches the
+// best keyed vertex of a splay subtree and a lazy flag reverses a subtree
+// when its path is re-rooted. Every operation is O(log V) amortized.
+//
+// Vertices are plain ints in parallel arrays, -1 is "none".
+template <typename Key>
+class LinkCutTree {
+public:
+    LinkCutTree() = default;
+
+    explicit LinkCutTree(int numVertices) { resize(numVertices); }
+
+    // grows the vertex range, new vertices are isolated and unkeyed
+    void resize(int numVertices) {
+        _children.resize(numVertices, { -1, -1 });
+        _parents.resize(numVertices, -1);
+        _reversed.resize(numVertices, false);
+        _keys.resize(numVertices);
+        _hasKey.resize(numVertices, false);
+        _pathMax.resize(numVertices, -1);
+    }
+
+    int getNumVertices() const { return static_cast<int>(_parents.size()); }
+
+    // only for an isolated vertex (not linked to anything)
+    void setKey(int vertex, const Key& key) {
+        _keys[vertex] = key;
+        _hasKey[vertex] = true;
+        _pathMax[vertex] = vertex;
+    }
+
+    void clearKey(int vertex) {
+        _hasKey[vertex] = false;
+        _pathMax[vertex] = -1;
+    }
+
+    const Key& getKey(int vertex) const { return _keys[vertex]; }
+
+    int findRoot(int vertex) {
+        access(vertex);
+        while (true) {
+            pushDown(vertex);
+            if (_children[vertex][0] == -1) {
+                break;
+            }
+            vertex = _children[vertex][0];
+        }
+        splay(vertex);
+        return vertex;
+    }
+
+    bool isConnected(int first, int second) { return first == second || findRoot(first) == findRoot(second); }
+
+    // first and second must be in different trees
+    void link(int first, int second) {
+        makeRoot(first);
+        _parents[first] = second;
+    }
+
+    // the tree edge (first, second) must exist
+    void cut(int first, int second) {
+        makeRoot(first);
+        access(second);
+        // first is the only vertex above second on the path
+        _children[second][0] = -1;
+        _parents[first] = -1;
+        update(second);
+    }
+
+    // keyed vertex with the largest key on the path first .. second, -1 when
+    // there is none; both must be connected
+    int findPathMax(int first, int second) {
+        makeRoot(first);
+        access(second);
+        return _pathMax[second];
+    }
+
+private:
+    bool isSplayRoot(int vertex) const {
+        int parent = _parents[vertex];
+        return parent == -1 || (_children[parent][0] != vertex && _children[parent][1] != vertex);
+    }
+
+    void reverse(int vertex) {
+        if (vertex != -1) {
+            std::swap(_children[vertex][0], _children[vertex][1]);
+            _reversed[vertex] = !_reversed[vertex];
+        }
+    }
+
+    void pushDown(int vertex) {
+        if (_reversed[vertex]) {
+            reverse(_children[vertex][0]);
+            reverse(_children[vertex][1]);
+            _reversed[vertex] = false;
+        }
+    }
+
+    void update(int vertex) {
+        int best = _hasKey[vertex] ? vertex : -1;
+        for (const int child : _children[vertex]) {
+            if (child != -1) {
+                int candidate = _pathMax[child];
+                if (candidate != -1 && (best == -1 || _keys[best] < _keys[candidate])) {
+                    best = candidate;
+                }
+            }
+        }
+        _pathMax[vertex] = best;
+    }
+
+    void rotate(int vertex) {
+        int parent = _parents[vertex];
+        int grandparent = _parents[parent];
+        int side = _children[parent][1] == vertex ? 1 : 0;
+
+        if (!isSplayRoot(parent)) {
+            _children[grandparent][_children[grandparent][1] == parent ? 1 : 0] = vertex;
+        }
+        _parents[vertex] = grandparent;
+
+        int moved = _children[vertex][1 - side];
+        _children[parent][side] = moved;
+        if (moved != -1) {
+            _parents[moved] = parent;
+        }
+
+        _children[vertex][1 - side] = parent;
+        _parents[parent] = vertex;
+
+        update(parent);
+        update(vertex);
+    }
+
+    void splay(int vertex) {
+        // pending reversals from the splay root down to vertex first
+        _splayPath.clear();
+        for (int current = vertex; ; current = _parents[current]) {
+            _splayPath.push_back(current);
+            if (isSplayRoot(current)) {
+                break;
+            }
+        }
+        for (auto it = _splayPath.rbegin(); it != _splayPath.rend(); ++it) {
+            pushDown(*it);
+        }
+
+        while (!isSplayRoot(vertex)) {
+            int parent = _parents[vertex];
+            if (!isSplayRoot(parent)) {
+                int grandparent = _parents[parent];
+                bool zigZig = (_children[parent][0] == vertex) == (_children[grandparent][0] == parent);
+                rotate(zigZig ? parent : vertex);
+            }
+            rotate(vertex);
+        }
+    }
+
+    // makes root .. vertex the preferred path, vertex ends up as the root of its splay tree
+    void access(int vertex) {
+        int last = -1;
+        for (int current = vertex; current != -1; current = _parents[current]) {
+            splay(current);
+            _children[current][1] = last;
+            update(current);
+            last = current;
+        }
+        splay(vertex);
+    }
+
+    void makeRoot(int vertex) {
+        access(vertex);
+        reverse(vertex);
+    }
+
+    std::vector<std::array<int, 2>> _children;
+    std::vector<int> _parents;   // splay parent, or path-parent for the root of a splay tree
+    std::vector<bool> _reversed;
+    std::vector<Key> _keys;
+    std::vector<bool> _hasKey;
+    std::vector<int> _pathMax;
+    std::vector<int> _splayPath;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <algorithm>
+
+#include "ThreadPool.h"
+
+// Splits [0, count) into numThreads contiguous chunks and runs
+// function(chunk, begin, end) for each of them in parallel on the global
+// ThreadPool. Chunk 0 runs on the calling thread; the call returns when every
+// chunk is done. Chunk i always gets the same range for the same count, so
+// per-chunk results can be combined in chunk order deterministically.
+//
+// Chunks are pool tasks, not threads of their own: no thread is created per
+// call, and with more chunks than pool threads the extra chunks wait for a
+// free thread (so chunks must not wait for each other). numThreads is the
+// number of chunks; how many of them really run at once is capped by the
+// size of the global pool - getDefaultNumThreads() unless
+// ThreadPool::configureGlobal set another one before the first parallel call.
+template <typename Function>
+void parallelForChunks(std::size_t count, int numThreads, Function function) {
+    numThreads = std::max(1, std::min<int>(numThreads, static_cast<int>(std::max<std::size_t>(count, 1))));
+
+    auto chunkBegin = [count, numThreads](int chunk) {
+        return count * chunk / numThreads;
+    };
+
+    if (numThreads == 1) {
+        function(0, chunkBegin(0), chunkBegin(1));
+        return;
+    }
+
+    TaskGroup group;
+    for (int chunk = 1; chunk < numThreads; chunk++) {
+        group.run([&function, &chunkBegin, chunk]() {
+            function(chunk, chunkBegin(chunk), chunkBegin(chunk + 1));
+        });
+    }
+
+    function(0, chunkBegin(0), chunkBegin(1));
+
+    group.wait();
+}
@@ -0,0 +1,335 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <algorithm>
+
+#include "CsrGraph.h"
+#include "IndexedDaryHeap.h"
+#include "Dijkstra.h"
+#include "Semiring.h"
+
+struct PointToPointResult {
+    int distance = std::numeric_limits<int>::max();   // max when dest is unreachable
+    std::vector<int> path;                            // start ... dest, empty when dest is unreachable
+    int numSettled{};
+};
+
+// A* heuristics: estimate(node, dest) is a lower bound of the distance from
+// node to dest. The three below are also consistent (ALT on strongly
+// connected graphs), so A* settles every node once; with a merely admissible
+// heuristic a node is queued again when its distance improves.
+
+// plain Dijkstra
+struct ZeroHeuristic {
+    int estimate(int, int) const { return 0; }
+};
+
+struct Coordinate {
+    double x{};
+    double y{};
+};
+
+// straight-line distance, valid when every arc weighs at least
+// weightPerUnit times the distance between its end points
+class EuclideanHeuristic {
+public:
+    EuclideanHeuristic(std::vector<Coordinate> coordinates, double weightPerUnit) :
+        _coordinates(std::move(coordinates)), _weightPerUnit(weightPerUnit) {}
+
+    int estimate(int node, int dest) const {
+        const Coordinate& from = _coordinates[node];
+        const Coordinate& to = _coordinates[dest];
+        return static_cast<int>(_weightPerUnit * std::hypot(from.x - to.x, from.y - to.y));
+    }
+
+private:
+    std::vector<Coordinate> _coordinates;
+    double _weightPerUnit{};
+};
+
+// ALT lower bounds from precomputed landmark distances and the triangle
+// inequality: d(v, t) >= d(L, t) - d(L, v) and d(v, t) >= d(v, L) - d(t, L).
+// The landmarks are picked farthest-first - every next landmark is the node
+// farthest from the ones picked so far - which spreads them over the
+// periphery where the bounds are tightest. Preprocessing is 2 * numLandmarks
+// one-to-all Dijkstras (one when the graph is undirected); the distances are
+// stored node-major so an estimate reads two short contiguous rows.
+class LandmarkHeuristic {
+public:
+    LandmarkHeuristic(const CsrGraph& graph, int numLandmarks, unsigned seed = 42) :
+        _numLandmarks(numLandmarks) {
+        const int INF = std::numeric_limits<int>::max();
+        int numNodes = graph.getNumNodes();
+
+        CsrGraph reverseGraph;
+        if (!graph.isUndirected()) {
+            std::vector<CsrEdge> edges = graph.toEdgeList();
+            for (CsrEdge& edge : edges) {
+                std::swap(edge.from, edge.to);
+            }
+            reverseGraph = CsrGraph(numNodes, edges);
+        }
+
+        _fromLandmark.assign(static_cast<std::size_t>(numNodes) * numLandmarks, INF);
+        _toLandmark.assign(static_cast<std::size_t>(numNodes) * numLandmarks, INF);
+
+        // distance of every node to the closest landmark picked so far
+        std::vector<long long> closest(numNodes, std::numeric_limits<long long>::max());
+        std::vector<int> distances, prevs;
+
+        std::mt19937 rng(seed);
+        int landmark = std::uniform_int_distribution<int>(0, numNodes - 1)(rng);
+        runDijkstra(graph, landmark, distances, prevs);
+        landmark = farthestNode(distances, closest, false);
+
+        for (int i = 0; i < numLandmarks; i++) {
+            _landmarks.push_back(landmark);
+
+            runDijkstra(graph, landmark, distances, prevs);
+            for (int node = 0; node < numNodes; node++) {
+                _fromLandmark[index(node, i)] = distances[node];
+            }
+            int nextLandmark = farthestNode(distances, closest, true);
+
+            if (!graph.isUndirected()) {
+                runDijkstra(reverseGraph, landmark, distances, prevs);
+            }
+            for (int node = 0; node < numNodes; node++) {
+                _toLandmark[index(node, i)] = distances[node];
+            }
+
+            landmark = nextLandmark;
+        }
+    }
+
+    const std::vector<int>& getLandmarks() const { return _landmarks; }
+
+    int estimate(int node, int dest) const {
+        const int INF = std::numeric_limits<int>::max();
+        int bound{};
+
+        for (int i = 0; i < _numLandmarks; i++) {
+            int fromToDest = _fromLandmark[index(dest, i)], fromToNode = _fromLandmark[index(node, i)];
+            if (fromToDest != INF && fromToNode != INF) {
+                bound = std::max(bound, fromToDest - fromToNode);
+            }
+
+            int nodeTo = _toLandmark[index(node, i)], destTo = _toLandmark[index(dest, i)];
+            if (nodeTo != INF && destTo != INF) {
+                bound = std::max(bound, nodeTo - destTo);
+            }
+        }
+
+        return bound;
+    }
+
+private:
+    std::size_t index(int node, int landmark) const {
+        return static_cast<std::size_t>(node) * _numLandmarks + landmark;
+    }
+
+    // reachable node with the largest distance to its closest landmark
+    static int farthestNode(const std::vector<int>& distances, std::vector<long long>& closest, bool updateClosest) {
+        int farthest = 0;
+        long long farthestDistance = -1;
+
+        for (int node = 0; node < static_cast<int>(distances.size()); node++) {
+            if (distances[node] == std::numeric_limits<int>::max()) {
+                continue;
+            }
+            if (updateClosest) {
+                closest[node] = std::min<long long>(closest[node], distances[node]);
+            }
+
+            long long distance = updateClosest ? closest[node] : distances[node];
+            if (distance > farthestDistance) {
+                farthestDistance = distance;
+                farthest = node;
+            }
+        }
+
+        return farthest;
+    }
+
+    int _numLandmarks{};
+    std::vector<int> _landmarks;
+    std::vector<int> _fromLandmark;
+    std::vector<int> _toLandmark;
+};
+
+// Single-pair shortest path queries on one graph (non-negative weights).
+// The labels are allocated once and only the nodes touched by a query are
+// reset before the next one, so a query costs O(explored part), not O(V).
+//
+//   findEarlyExit     Dijkstra that stops when dest is settled
+//   findBidirectional forward search from start and backward search from dest
+//                     over the reverse CSR (or the arcs themselves when the
+//                     graph is undirected); the side with the smaller queue
+//                     head advances and the search stops once the two heads
+//                     together reach the best meeting distance
+//   findAStar         Dijkstra on the keys distance + heuristic.estimate(node, dest)
+//
+// All modes return the same distance as a full Dijkstra. The graph is kept by
+// reference and must outlive the query object.
+template <int Arity = 4>
+class PointToPointDijkstra {
+public:
+    explicit PointToPointDijkstra(const CsrGraph& graph) :
+        _graph(graph), _forward(graph.getNumNodes()), _backward(graph.getNumNodes()) {}
+
+    PointToPointResult findEarlyExit(int startNode, int destNode) {
+        return findAStar(startNode, destNode, ZeroHeuristic());
+    }
+
+    template <typename Heuristic>
+    PointToPointResult findAStar(int startNode, int destNode, const Heuristic& heuristic) {
+        _forward.reset();
+
+        PointToPointResult result;
+        _forward.label(startNode, 0, -1);
+        _forward.heap.push(startNode, heuristic.estimate(startNode, destNode));
+
+        while (!_forward.heap.empty()) {
+            int minNode = _forward.heap.pop();
+            int minDistance = _forward.distances[minNode];
+            result.numSettled++;
+
+            if (minNode == destNode) {
+                result.distance = minDistance;
+                result.path = _forward.pathTo(destNode);
+                break;
+            }
+
+            for (int arc = _graph.getFirstArc(minNode); arc < _graph.getLastArc(minNode); arc++) {
+                int child = _graph.getTarget(arc);
+                int newDistance = MinPlus<int>::extend(minDistance, _graph.getWeight(arc));
+
+                if (newDistance < _forward.distances[child]) {
+                    _forward.label(child, newDistance, minNode);
+                    _forward.heap.pushOrDecrease(
+                        child, SemiringDetail::saturatingAdd(newDistance, heuristic.estimate(child, destNode)));
+                }
+            }
+        }
+
+        return result;
+    }
+
+    PointToPointResult findBidirectional(int startNode, int destNode) {
+        if (!_graph.hasReverse() && !_graph.isUndirected()) {
+            throw std::runtime_error("bidirectional search needs an undirected graph or a reverse CSR");
+        }
+
+        const long long INF = std::numeric_limits<int>::max();
+
+        _forward.reset();
+        _backward.reset();
+
+        PointToPointResult result;
+        _forward.label(startNode, 0, -1);
+        _forward.heap.push(startNode, 0);
+        _backward.label(destNode, 0, -1);
+        _backward.heap.push(destNode, 0);
+
+        long long bestDistance = startNode == destNode ? 0 : INF;
+        int meetingNode = startNode == destNode ? startNode : -1;
+
+        while (!_forward.heap.empty() || !_backward.heap.empty()) {
+            long long forwardTop = _forward.heap.empty() ? INF : _forward.heap.topKey();
+            long long backwardTop = _backward.heap.empty() ? INF : _backward.heap.topKey();
+            if (forwardTop + backwardTop >= bestDistance) {
+                break;
+            }
+
+            bool isForward = forwardTop <= backwardTop;
+            SearchSide& side = isForward ? _forward : _backward;
+            SearchSide& other = isForward ? _backward : _forward;
+
+            int minNode = side.heap.pop();
+            int minDistance = side.distances[minNode];
+            result.numSettled++;
+
+            auto relax = [&](int child, int weight) {
+                int newDistance = MinPlus<int>::extend(minDistance, weight);
+                if (newDistance < side.distances[child]) {
+                    side.label(child, newDistance, minNode);
+                    side.heap.pushOrDecrease(child, newDistance);
+                }
+
+                if (other.distances[child] != INF &&
+                    static_cast<long long>(side.distances[child]) + other.distances[child] < bestDistance) {
+                    bestDistance = static_cast<long long>(side.distances[child]) + other.distances[child];
+                    meetingNode = child;
+                }
+            };
+
+            if (isForward || _graph.isUndirected()) {
+                for (int arc = _graph.getFirstArc(minNode); arc < _graph.getLastArc(minNode); arc++) {
+                    relax(_graph.getTarget(arc), _graph.getWeight(arc));
+                }
+            } else {
+                for (int inArc = _graph.getFirstInArc(minNode); inArc < _graph.getLastInArc(minNode); inArc++) {
+                    relax(_graph.getInSource(inArc), _graph.getInWeight(inArc));
+                }
+            }
+        }
+
+        if (meetingNode != -1) {
+            result.distance = static_cast<int>(bestDistance);
+            result.path = _forward.pathTo(meetingNode);
+
+            // the backward prevs point towards dest
+            for (int node = _backward.prevs[meetingNode]; node != -1; node = _backward.prevs[node]) {
+                result.path.push_back(node);
+            }
+        }
+
+        return result;
+    }
+
+private:
+    struct SearchSide {
+        std::vector<int> distances;
+        std::vector<int> prevs;
+        std::vector<int> touched;
+        IndexedDaryHeap<int, Arity> heap;
+
+        explicit SearchSide(int numNodes) :
+            distances(numNodes, std::numeric_limits<int>::max()), prevs(numNodes, -1), heap(numNodes) {}
+
+        void label(int node, int distance, int prev) {
+            if (distances[node] == std::numeric_limits<int>::max()) {
+                touched.push_back(node);
+            }
+            distances[node] = distance;
+            prevs[node] = prev;
+        }
+
+        // only the labels of the previous query are cleared
+        void reset() {
+            for (const int node : touched) {
+                distances[node] = std::numeric_limits<int>::max();
+                prevs[node] = -1;
+            }
+            touched.clear();
+            heap.clear();
+        }
+
+        std::vector<int> pathTo(int node) const {
+            std::vector<int> path;
+            for (; node != -1; node = prevs[node]) {
+                path.push_back(node);
+            }
+            std::reverse(path.begin(), path.end());
+            return path;
+        }
+    };
+
+    const CsrGraph& _graph;
+    SearchSide _forward;
+    SearchSide _backward;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+
+#include "CsrGraph.h"
+#include "IndexedDaryHeap.h"
+
+// Prim's algorithm over an undirected CSR graph. Instead of queueing every
+// candidate edge, the heap holds each non-tree node once, keyed by the
+// weight of its cheapest edge into the tree (decrease-key when a cheaper one
+// shows up) - O(E log V) time and O(V) extra memory. Visited nodes are a
+// bitset and the heap, bitset and best-edge arrays are reused for every tree
+// of a forest. Weight is the arc weight type of the graph.
+template <int Arity = 4, typename Weight = int>
+class PrimMstBuilder {
+public:
+    explicit PrimMstBuilder(const BasicCsrGraph<Weight>& graph) :
+        _graph(graph), _visited(graph.getNumNodes(), false), _heap(graph.getNumNodes()),
+        _bestEdgeIds(graph.getNumNodes(), -1) {}
+
+    bool isVisited(int node) const { return _visited[node]; }
+
+    // grows the tree that contains startNode and appends the ids of its edges in the order they join
+    void growTree(int startNode, std::vector<int>& treeEdgeIds) {
+        _visited[startNode] = true;
+        addNeighbours(startNode);
+
+        while (!_heap.empty()) {
+            int node = _heap.pop();
+
+            _visited[node] = true;
+            treeEdgeIds.push_back(_bestEdgeIds[node]);
+
+            addNeighbours(node);
+        }
+    }
+
+    // one tree per connected component, isolated nodes contribute nothing
+    std::vector<int> findForest() {
+        std::vector<int> forestEdgeIds;
+
+        for (int node = 0; node < _graph.getNumNodes(); node++) {
+            if (!_visited[node] && _graph.getOutDegree(node) > 0) {
+                growTree(node, forestEdgeIds);
+            }
+        }
+
+        return forestEdgeIds;
+    }
+
+private:
+    void addNeighbours(int node) {
+        for (int arc = _graph.getFirstArc(node); arc < _graph.getLastArc(node); arc++) {
+            int neighbour = _graph.getTarget(arc);
+            if (!_visited[neighbour] && _heap.pushOrDecrease(neighbour, _graph.getWeight(arc))) {
+                _bestEdgeIds[neighbour] = _graph.getEdgeId(arc);
+            }
+        }
+    }
+
+    const BasicCsrGraph<Weight>& _graph;
+    std::vector<bool> _visited;
+    IndexedDaryHeap<Weight, Arity> _heap;
+    std::vector<int> _bestEdgeIds;
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include "Parallel.h"
+
+// Stable LSD radix sort of the indices [0, count) by the 64-bit keys
+// getKey(i), one byte per pass. Each pass is parallel: every thread counts
+// the digits of its chunk, an exclusive scan in (digit, thread) order gives
+// each thread its own output slots, and the scatter keeps the input order of
+// equal digits - so the result is identical for any number of threads.
+// Passes over bytes that are the same for all keys are skipped.
+template <typename GetKey>
+std::vector<std::uint32_t> radixSortIndicesByKey(std::size_t count, GetKey getKey,
+                                                 int numThreads = getDefaultNumThreads()) {
+    constexpr int RADIX = 256;
+
+    std::vector<std::uint64_t> keys(count), keysBuffer(count);
+    std::vector<std::uint32_t> order(count), orderBuffer(count);
+
+    numThreads = std::max(1, std::min<int>(numThreads, static_cast<int>(count / 65536) + 1));
+
+    std::vector<std::uint64_t> orMasks(numThreads, 0), andMasks(numThreads, ~std::uint64_t{});
+    parallelForChunks(count, numThreads, [&](int chunk, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            keys[i] = getKey(i);
+            order[i] = static_cast<std::uint32_t>(i);
+            orMasks[chunk] |= keys[i];
+            andMasks[chunk] &= keys[i];
+        }
+    });
+
+    // bits that differ between at least two keys
+    std::uint64_t orMask{}, andMask = ~std::uint64_t{};
+    for (int chunk = 0; chunk < numThreads; chunk++) {
+        orMask |= orMasks[chunk];
+        andMask &= andMasks[chunk];
+    }
+    std::uint64_t varyingBits = orMask & ~andMask;
+
+    std::vector<std::array<std::size_t, RADIX>> counts(numThreads);
+
+    for (int shift = 0; shift < 64; shift += 8) {
+        if (((varyingBits >> shift) & 0xFF) == 0) {
+            continue;
+        }
+
+        parallelForChunks(count, numThreads, [&](int chunk, std::size_t begin, std::size_t end) {
+            counts[chunk].fill(0);
+            for (std::size_t i = begin; i < end; i++) {
+                counts[chunk][(keys[i] >> shift) & 0xFF]++;
+            }
+        });
+
+        std::size_t offset{};
+        for (int digit = 0; digit < RADIX; digit++) {
+            for (int chunk = 0; chunk < numThreads; chunk++) {
+                std::size_t digitCount = counts[chunk][digit];
+                counts[chunk][digit] = offset;
+                offset += digitCount;
+            }
+        }
+
+        parallelForChunks(count, numThreads, [&](int chunk, std::size_t begin, std::size_t end) {
+            std::array<std::size_t, RADIX>& nextSlot = counts[chunk];
+            for (std::size_t i = begin; i < end; i++) {
+                std::size_t slot = nextSlot[(keys[i] >> shift) & 0xFF]++;
+                keysBuffer[slot] = keys[i];
+                orderBuffer[slot] = order[i];
+            }
+        });
+
+        keys.swap(keysBuffer);
+        order.swap(orderBuffer);
+    }
+
+    return order;
+}
+
+// Weights mapped to unsigned keys with the same order, so Kruskal can radix
+// sort edges of any weight type. 32-bit weights fit in the low half of the
+// key and leave the high half for a tie-breaker.
+inline std::uint64_t toRadixKey(std::int32_t value) {
+    return static_cast<std::uint32_t>(value) ^ 0x80000000u;
+}
+
+inline std::uint64_t toRadixKey(std::uint32_t value) {
+    return value;
+}
+
+inline std::uint64_t toRadixKey(std::int64_t value) {
+    return static_cast<std::uint64_t>(value) ^ 0x8000000000000000ull;
+}
+
+inline std::uint64_t toRadixKey(std::uint64_t value) {
+    return value;
+}
+
+// IEEE 754: flip all bits of negatives, only the sign bit of the rest
+inline std::uint64_t toRadixKey(float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits & 0x80000000u ? ~bits : bits | 0x80000000u;
+}
+
+inline std::uint64_t toRadixKey(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits & 0x8000000000000000ull ? ~bits : bits | 0x8000000000000000ull;
+}
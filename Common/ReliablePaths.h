@@ -0,0 +1,285 @@
+#pragma once
+
+#include <set>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include <algorithm>
+
+#include "CsrGraph.h"
+#include "IndexedDaryHeap.h"
+
+// Most reliable paths in log space. An arc that works with probability p
+// costs -log(p) >= 0, so the reliability of a path - the product of its
+// probabilities - is exp(-(sum of costs)) and the most reliable path is a
+// plain shortest path. Sums of logs do not underflow on long paths the way
+// products of probabilities do, and the search is an ordinary min-sum
+// Dijkstra.
+
+using LogCostGraph = BasicCsrGraph<double>;
+
+// -log(p) for a probability in [0, 1], +infinity for p == 0 (the arc never works)
+inline double toLogCost(double probability) {
+    if (!(probability >= 0.0 && probability <= 1.0)) {
+        throw std::runtime_error("Probability " + std::to_string(probability) + " is not in [0, 1]");
+    }
+    return probability == 0.0 ? std::numeric_limits<double>::infinity() : -std::log(probability);
+}
+
+// log cost graph of (from, to, probability) edges
+inline LogCostGraph buildLogCostGraph(int numNodes, const std::vector<BasicCsrEdge<double>>& probabilityEdges,
+                                      bool undirected = false, bool withReverse = false) {
+    std::vector<BasicCsrEdge<double>> edges;
+    edges.reserve(probabilityEdges.size());
+    for (const BasicCsrEdge<double>& edge : probabilityEdges) {
+        edges.emplace_back(edge.from, edge.to, toLogCost(edge.weight));
+    }
+
+    return LogCostGraph(numNodes, edges, undirected, withReverse);
+}
+
+struct ReliablePath {
+    std::vector<int> nodes;   // start ... dest, empty when dest is unreachable
+    std::vector<int> arcs;    // arc ids in the log cost graph, nodes.size() - 1 of them
+    double logLikelihood = -std::numeric_limits<double>::infinity();   // sum of log(p) over the arcs
+
+    bool isFound() const { return !nodes.empty(); }
+    double getReliability() const { return std::exp(logLikelihood); }
+    double getPercentage() const { return 100.0 * getReliability(); }
+};
+
+// Point-to-point queries on a log cost graph. The search arrays are sized
+// once and reset through the list of touched nodes, so repeated queries - and
+// the many spur searches of findMostReliablePaths - cost O(visited), not O(V).
+//
+// findMostReliablePaths needs an undirected graph or a reverse CSR for its
+// A* speed-up, without either it falls back to plain Dijkstra spur searches.
+template <int Arity = 4>
+class ReliablePathFinder {
+public:
+    explicit ReliablePathFinder(const LogCostGraph& graph) :
+        _graph(graph),
+        _costs(graph.getNumNodes(), std::numeric_limits<double>::infinity()),
+        _prevArcs(graph.getNumNodes(), -1),
+        _heap(graph.getNumNodes()),
+        _bannedNodes(graph.getNumNodes(), 0),
+        _bannedArcs(graph.getNumArcs(), 0) {}
+
+    ReliablePath findMostReliablePath(int start, int dest) {
+        std::vector<int> arcs;
+        if (!search(start, dest, arcs)) {
+            return {};
+        }
+        return makePath(start, arcs);
+    }
+
+    // Up to k loopless paths from start to dest, most reliable first (Yen's
+    // algorithm): path i + 1 is the best deviation from paths 1..i. For every
+    // node of the last accepted path a spur search runs with the root part of
+    // the path blocked - its nodes, and the next arcs of all accepted paths
+    // sharing that root - so every candidate differs from every accepted path.
+    // Candidates are kept ordered by (cost, arcs), which makes ties
+    // deterministic and drops duplicates. O(k V) spur searches.
+    //
+    // Blocking nodes and arcs only makes paths more expensive, so the exact
+    // costs to dest in the unblocked graph (one backward search) are an
+    // admissible and consistent A* heuristic for every spur search. Spur
+    // searches then head straight for dest instead of growing a ball around
+    // the spur node.
+    std::vector<ReliablePath> findMostReliablePaths(int start, int dest, int k) {
+        std::vector<ReliablePath> accepted;
+        if (k <= 0) {
+            return accepted;
+        }
+
+        computeCostsToDest(dest);
+
+        ReliablePath best = findMostReliablePath(start, dest);
+        if (!best.isFound()) {
+            _costsToDest.clear();
+            return accepted;
+        }
+        accepted.push_back(std::move(best));
+
+        std::set<std::pair<double, std::vector<int>>> candidates;
+
+        while (static_cast<int>(accepted.size()) < k) {
+            const ReliablePath& last = accepted.back();
+
+            for (std::size_t spurIndex = 0; spurIndex + 1 < last.nodes.size(); spurIndex++) {
+                int spurNode = last.nodes[spurIndex];
+                auto rootBegin = last.arcs.begin();
+                auto rootEnd = last.arcs.begin() + spurIndex;
+
+                std::vector<int> bannedArcs;
+                for (const ReliablePath& path : accepted) {
+                    if (path.arcs.size() > spurIndex && std::equal(rootBegin, rootEnd, path.arcs.begin())) {
+                        bannedArcs.push_back(path.arcs[spurIndex]);
+                    }
+                }
+                for (const int arc : bannedArcs) {
+                    _bannedArcs[arc] = 1;
+                }
+                for (std::size_t i = 0; i < spurIndex; i++) {
+                    _bannedNodes[last.nodes[i]] = 1;
+                }
+
+                std::vector<int> spurArcs;
+                if (search(spurNode, dest, spurArcs)) {
+                    std::vector<int> arcs(rootBegin, rootEnd);
+                    arcs.insert(arcs.end(), spurArcs.begin(), spurArcs.end());
+                    candidates.emplace(sumCosts(arcs), std::move(arcs));
+                }
+
+                for (const int arc : bannedArcs) {
+                    _bannedArcs[arc] = 0;
+                }
+                for (std::size_t i = 0; i < spurIndex; i++) {
+                    _bannedNodes[last.nodes[i]] = 0;
+                }
+            }
+
+            if (candidates.empty()) {
+                break;
+            }
+
+            accepted.push_back(makePath(start, candidates.begin()->second));
+            candidates.erase(candidates.begin());
+        }
+
+        _costsToDest.clear();
+        return accepted;
+    }
+
+private:
+    // exact costs from every node to dest into _costsToDest, left empty when
+    // the incoming arcs of the graph are not available
+    void computeCostsToDest(int dest) {
+        const double INF = std::numeric_limits<double>::infinity();
+
+        _costsToDest.clear();
+        if (!_graph.isUndirected() && !_graph.hasReverse()) {
+            return;
+        }
+
+        bool useOutArcs = _graph.isUndirected();
+        _costsToDest.assign(_graph.getNumNodes(), INF);
+        IndexedDaryHeap<double, Arity> heap(_graph.getNumNodes());
+
+        _costsToDest[dest] = 0.0;
+        heap.push(dest, 0.0);
+
+        while (!heap.empty()) {
+            int minNode = heap.pop();
+            int first = useOutArcs ? _graph.getFirstArc(minNode) : _graph.getFirstInArc(minNode);
+            int last = useOutArcs ? _graph.getLastArc(minNode) : _graph.getLastInArc(minNode);
+
+            for (int arc = first; arc < last; arc++) {
+                int source = useOutArcs ? _graph.getTarget(arc) : _graph.getInSource(arc);
+                double newCost = _costsToDest[minNode] + (useOutArcs ? _graph.getWeight(arc) : _graph.getInWeight(arc));
+                if (newCost < _costsToDest[source]) {
+                    _costsToDest[source] = newCost;
+                    heap.pushOrDecrease(source, newCost);
+                }
+            }
+        }
+    }
+
+    // lower bound of the cost from node to dest, 0 without _costsToDest
+    double estimateToDest(int node) const {
+        return _costsToDest.empty() ? 0.0 : _costsToDest[node];
+    }
+
+    // Dijkstra (A* with _costsToDest) from start to dest around the banned
+    // nodes and arcs, the arcs of the path in arcs; false when dest can not
+    // be reached
+    bool search(int start, int dest, std::vector<int>& arcs) {
+        const double INF = std::numeric_limits<double>::infinity();
+
+        for (const int node : _touched) {
+            _costs[node] = INF;
+            _prevArcs[node] = -1;
+        }
+        _touched.clear();
+        _heap.clear();
+
+        if (estimateToDest(start) == INF) {
+            arcs.clear();
+            return false;
+        }
+
+        _costs[start] = 0.0;
+        _touched.push_back(start);
+        _heap.push(start, estimateToDest(start));
+
+        bool found = false;
+        while (!_heap.empty()) {
+            int minNode = _heap.pop();
+            if (minNode == dest) {
+                found = true;
+                break;
+            }
+
+            for (int arc = _graph.getFirstArc(minNode); arc < _graph.getLastArc(minNode); arc++) {
+                int child = _graph.getTarget(arc);
+                if (_bannedArcs[arc] || _bannedNodes[child]) {
+                    continue;
+                }
+
+                double newCost = _costs[minNode] + _graph.getWeight(arc);
+                if (newCost < _costs[child] && estimateToDest(child) != INF) {
+                    if (_costs[child] == INF) {
+                        _touched.push_back(child);
+                    }
+                    _costs[child] = newCost;
+                    _prevArcs[child] = arc;
+                    _heap.pushOrDecrease(child, newCost + estimateToDest(child));
+                }
+            }
+        }
+
+        arcs.clear();
+        if (!found) {
+            return false;
+        }
+
+        for (int node = dest; node != start; node = _graph.findSource(_prevArcs[node])) {
+            arcs.push_back(_prevArcs[node]);
+        }
+        std::reverse(arcs.begin(), arcs.end());
+        return true;
+    }
+
+    // summed in path order, so equal paths always get bit-identical costs
+    double sumCosts(const std::vector<int>& arcs) const {
+        double cost{};
+        for (const int arc : arcs) {
+            cost += _graph.getWeight(arc);
+        }
+        return cost;
+    }
+
+    ReliablePath makePath(int start, const std::vector<int>& arcs) const {
+        ReliablePath path;
+        path.arcs = arcs;
+        path.nodes.reserve(arcs.size() + 1);
+        path.nodes.push_back(start);
+        for (const int arc : arcs) {
+            path.nodes.push_back(_graph.getTarget(arc));
+        }
+        path.logLikelihood = -sumCosts(arcs);
+        return path;
+    }
+
+    const LogCostGraph& _graph;
+    std::vector<double> _costs;
+    std::vector<int> _prevArcs;
+    std::vector<int> _touched;
+    std::vector<double> _costsToDest;
+    IndexedDaryHeap<double, Arity> _heap;
+    std::vector<char> _bannedNodes;
+    std::vector<char> _bannedArcs;
+};
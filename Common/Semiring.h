@@ -0,0 +1,113 @@
+#pragma once
+
+#include <limits>
+#include <type_traits>
+
+// Path semirings for the templated Dijkstra, Bellman-Ford and DAG path
+// engines. A semiring fixes the weight type and three things:
+//
+//   zero()          label of an unreached node, absorbing under extend
+//   one()           label of the start node
+//   extend(d, w)    label of a path with label d extended by an arc of weight w
+//   isBetter(a, b)  strict order the search optimises for
+//
+// Everything is static and inline, so an engine instantiated for a semiring
+// compiles to the same code as one written for that weight type by hand.
+// Integer labels saturate instead of overflowing: a path that would leave the
+// range of Weight ends up at the limit (zero() for the "no path" side), it can
+// never wrap around into a good label.
+
+namespace SemiringDetail {
+
+// a + b clamped to [lowest, max] of an integer type, plain a + b otherwise
+template <typename Weight>
+Weight saturatingAdd(Weight a, Weight b) {
+    if constexpr (std::is_integral_v<Weight>) {
+        if (b > 0 && a > std::numeric_limits<Weight>::max() - b) {
+            return std::numeric_limits<Weight>::max();
+        }
+        if constexpr (std::is_signed_v<Weight>) {
+            if (b < 0 && a < std::numeric_limits<Weight>::lowest() - b) {
+                return std::numeric_limits<Weight>::lowest();
+            }
+        }
+    }
+    return a + b;
+}
+
+// +infinity for floating point weights, the largest value for integers
+template <typename Weight>
+constexpr Weight highest() {
+    if constexpr (std::numeric_limits<Weight>::has_infinity) {
+        return std::numeric_limits<Weight>::infinity();
+    } else {
+        return std::numeric_limits<Weight>::max();
+    }
+}
+
+// -infinity for floating point weights, the smallest value for integers
+template <typename Weight>
+constexpr Weight lowest() {
+    if constexpr (std::numeric_limits<Weight>::has_infinity) {
+        return -std::numeric_limits<Weight>::infinity();
+    } else {
+        return std::numeric_limits<Weight>::lowest();
+    }
+}
+
+} // namespace SemiringDetail
+
+// shortest paths: (min, +), unreached = the largest value
+template <typename Weight>
+struct MinPlus {
+    using WeightType = Weight;
+
+    static constexpr Weight zero() { return SemiringDetail::highest<Weight>(); }
+    static constexpr Weight one() { return Weight{}; }
+
+    static Weight extend(Weight distance, Weight weight) {
+        return distance == zero() ? zero() : SemiringDetail::saturatingAdd(distance, weight);
+    }
+
+    static bool isBetter(Weight distance, Weight otherDistance) { return distance < otherDistance; }
+};
+
+// longest paths: (max, +), unreached = the smallest value
+template <typename Weight>
+struct MaxPlus {
+    // the smallest unsigned value is 0, the label of the start node - unreached could not be told apart
+    static_assert(std::is_signed_v<Weight> || std::numeric_limits<Weight>::has_infinity,
+                  "Longest paths need a signed or floating point weight type");
+
+    using WeightType = Weight;
+
+    static constexpr Weight zero() { return SemiringDetail::lowest<Weight>(); }
+    static constexpr Weight one() { return Weight{}; }
+
+    static Weight extend(Weight distance, Weight weight) {
+        return distance == zero() ? zero() : SemiringDetail::saturatingAdd(distance, weight);
+    }
+
+    static bool isBetter(Weight distance, Weight otherDistance) { return distance > otherDistance; }
+};
+
+// most reliable paths: (max, *) over probabilities in [0, 1], unreached = 0
+template <typename Weight>
+struct MaxTimes {
+    using WeightType = Weight;
+
+    static constexpr Weight zero() { return Weight{}; }
+    static constexpr Weight one() { return Weight{ 1 }; }
+
+    static Weight extend(Weight probability, Weight weight) { return probability * weight; }
+
+    static bool isBetter(Weight probability, Weight otherProbability) { return probability > otherProbability; }
+};
+
+// Compare for IndexedDaryHeap: the better label first
+template <typename Semiring>
+struct SemiringOrder {
+    bool operator()(typename Semiring::WeightType first, typename Semiring::WeightType second) const {
+        return Semiring::isBetter(first, second);
+    }
+};
@@ -0,0 +1,336 @@
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+inline int getDefaultNumThreads() {
+    unsigned hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads == 0 ? 1 : static_cast<int>(hardwareThreads);
+}
+
+// Persistent work-stealing thread pool shared by the parallel kernels.
+//
+// Every worker owns a deque: tasks it submits go to the back and it pops
+// from the back (the newest, cache-hot task), idle workers steal from the
+// front of the others (the oldest, usually the biggest piece of a recursive
+// split). Tasks from threads outside the pool go to a shared injection
+// queue. Idle workers sleep on a condition variable, so an unused pool costs
+// nothing. A thread that waits for tasks (TaskGroup::wait) runs queued tasks
+// meanwhile, which makes nested parallelism safe and lets a pool without
+// workers still finish everything on the waiting thread.
+//
+// The deques are mutex-guarded; a task is a grain of work (a chunk, a
+// range), so the lock is cheap next to it.
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    // pinThreads binds worker i to the (i + 1)-th CPU, cyclically, of the
+    // CPUs the process may run on (its affinity mask - taskset, cgroup
+    // cpuset); the first one is left to the thread that owns the pool. Linux
+    // only - getNumPinnedWorkers tells how many workers were really pinned.
+    explicit ThreadPool(int numWorkers, bool pinThreads = false) {
+        numWorkers = std::max(0, numWorkers);
+        for (int i = 0; i <= numWorkers; i++) {
+            _queues.push_back(std::make_unique<WorkQueue>());
+        }
+
+        std::vector<int> cpus = pinThreads ? getAllowedCpus() : std::vector<int>();
+
+        _workers.reserve(numWorkers);
+        for (int i = 0; i < numWorkers; i++) {
+            _workers.emplace_back([this, i]() { workerLoop(i); });
+            if (!cpus.empty() && pinToCpu(_workers.back(), cpus[(i + 1) % cpus.size()])) {
+                _numPinnedWorkers++;
+            }
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+            _stopping = true;
+        }
+        _wakeUp.notify_all();
+
+        for (std::thread& worker : _workers) {
+            worker.join();
+        }
+    }
+
+    int getNumWorkers() const { return static_cast<int>(_workers.size()); }
+    int getNumPinnedWorkers() const { return _numPinnedWorkers; }
+
+    void submit(Task task) {
+        int queue = t_pool == this ? t_workerIndex : getInjectionQueue();
+        {
+            std::lock_guard<std::mutex> lock(_queues[queue]->mutex);
+            _queues[queue]->tasks.push_back(std::move(task));
+        }
+        _numQueued++;
+
+        // taking the lock orders the push before a worker's sleep check - no lost wake-up
+        { std::lock_guard<std::mutex> lock(_sleepMutex); }
+        _wakeUp.notify_one();
+    }
+
+    // runs one queued task on the calling thread, false when there was none
+    bool runPendingTask() {
+        Task task;
+        if (!tryTake(t_pool == this ? t_workerIndex : -1, task)) {
+            return false;
+        }
+        task();
+        return true;
+    }
+
+    // Pool used by parallelForChunks and parallelFor: getDefaultNumThreads()
+    // threads in all - the caller plus one worker less. Created on first use;
+    // configureGlobal before that changes its size and pinning, afterwards it
+    // throws.
+    static ThreadPool& getGlobal() {
+        static ThreadPool pool = [] {
+            getGlobalConfig().created = true;
+            return ThreadPool(getGlobalConfig().numThreads - 1, getGlobalConfig().pinThreads);
+        }();
+        return pool;
+    }
+
+    static void configureGlobal(int numThreads, bool pinThreads = false) {
+        if (getGlobalConfig().created) {
+            throw std::runtime_error("The global thread pool is already running, configure it before its first use");
+        }
+        getGlobalConfig().numThreads = std::max(1, numThreads);
+        getGlobalConfig().pinThreads = pinThreads;
+    }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    struct GlobalConfig {
+        int numThreads = getDefaultNumThreads();
+        bool pinThreads = false;
+        bool created = false;
+    };
+
+    static GlobalConfig& getGlobalConfig() {
+        static GlobalConfig config;
+        return config;
+    }
+
+    int getInjectionQueue() const { return static_cast<int>(_queues.size()) - 1; }
+
+    // own deque from the back, then the injection queue, then the other deques from the front
+    bool tryTake(int self, Task& task) {
+        if (_numQueued.load(std::memory_order_relaxed) == 0) {
+            return false;
+        }
+
+        if (self >= 0 && takeFrom(self, true, task)) {
+            return true;
+        }
+
+        int numQueues = static_cast<int>(_queues.size());
+        int first = self >= 0 ? self + 1 : 0;
+        for (int i = 0; i < numQueues; i++) {
+            int victim = (first + i) % numQueues;
+            if (victim != self && takeFrom(victim, false, task)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool takeFrom(int queue, bool fromBack, Task& task) {
+        std::lock_guard<std::mutex> lock(_queues[queue]->mutex);
+        std::deque<Task>& tasks = _queues[queue]->tasks;
+        if (tasks.empty()) {
+            return false;
+        }
+
+        if (fromBack) {
+            task = std::move(tasks.back());
+            tasks.pop_back();
+        } else {
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        _numQueued--;
+        return true;
+    }
+
+    void workerLoop(int index) {
+        t_pool = this;
+        t_workerIndex = index;
+
+        Task task;
+        while (true) {
+            if (tryTake(index, task)) {
+                task();
+                task = nullptr;
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(_sleepMutex);
+            _wakeUp.wait(lock, [this]() { return _stopping || _numQueued > 0; });
+            if (_stopping && _numQueued == 0) {
+                return;
+            }
+        }
+    }
+
+    // CPUs in the affinity mask of the process, empty where that is unknown
+    static std::vector<int> getAllowedCpus() {
+        std::vector<int> cpus;
+#ifdef __linux__
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+                if (CPU_ISSET(cpu, &allowed)) {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+#endif
+        return cpus;
+    }
+
+    static bool pinToCpu(std::thread& thread, int cpu) {
+#ifdef __linux__
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        return pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus) == 0;
+#else
+        (void)thread;
+        (void)cpu;
+        return false;
+#endif
+    }
+
+    std::vector<std::unique_ptr<WorkQueue>> _queues;   // one per worker, the last one for outside threads
+    std::vector<std::thread> _workers;
+    int _numPinnedWorkers{};
+    std::atomic<int> _numQueued{ 0 };
+
+    std::mutex _sleepMutex;
+    std::condition_variable _wakeUp;
+    bool _stopping = false;
+
+    inline static thread_local ThreadPool* t_pool = nullptr;   // pool of the current worker thread
+    inline static thread_local int t_workerIndex = -1;
+};
+
+// Fork/join on a ThreadPool: run() forks a task, wait() joins all of them -
+// running queued tasks meanwhile instead of blocking. The first exception a
+// task throws is rethrown by wait().
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::getGlobal()) : _pool(pool) {}
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    ~TaskGroup() {
+        // a group left by an exception still has to outlive its tasks
+        while (_numPending.load(std::memory_order_acquire) > 0) {
+            if (!_pool.runPendingTask()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    template <typename Function>
+    void run(Function function) {
+        _numPending++;
+        _pool.submit([this, function = std::move(function)]() mutable {
+            try {
+                function();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(_errorMutex);
+                if (!_error) {
+                    _error = std::current_exception();
+                }
+            }
+            _numPending.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    void wait() {
+        while (_numPending.load(std::memory_order_acquire) > 0) {
+            if (!_pool.runPendingTask()) {
+                std::this_thread::yield();
+            }
+        }
+
+        if (_error) {
+            std::exception_ptr error = _error;
+            _error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    ThreadPool& _pool;
+    std::atomic<int> _numPending{ 0 };
+    std::mutex _errorMutex;
+    std::exception_ptr _error;
+};
+
+namespace ThreadPoolDetail {
+
+template <typename Function>
+void splitRange(std::size_t begin, std::size_t end, std::size_t grainSize, Function& function, ThreadPool& pool) {
+    if (end - begin <= grainSize) {
+        function(begin, end);
+        return;
+    }
+
+    std::size_t middle = begin + (end - begin) / 2;
+    TaskGroup group(pool);
+    group.run([&]() { splitRange(middle, end, grainSize, function, pool); });
+    splitRange(begin, middle, grainSize, function, pool);
+    group.wait();
+}
+
+} // namespace ThreadPoolDetail
+
+// Runs function(rangeBegin, rangeEnd) over [begin, end) split in halves down
+// to at most grainSize indices, the halves forked on the pool - idle workers
+// steal the big halves, so uneven work balances itself. grainSize 0 picks
+// about 8 pieces per pool thread.
+template <typename Function>
+void parallelFor(std::size_t begin, std::size_t end, std::size_t grainSize, Function function,
+                 ThreadPool& pool = ThreadPool::getGlobal()) {
+    if (begin >= end) {
+        return;
+    }
+    if (grainSize == 0) {
+        grainSize = std::max<std::size_t>(1, (end - begin) / (8 * static_cast<std::size_t>(pool.getNumWorkers() + 1)));
+    }
+
+    ThreadPoolDetail::splitRange(begin, end, grainSize, function, pool);
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include "CsrGraph.h"
+
+struct TopologicalOrder {
+    std::vector<int> order;          // every node, each one after all of its predecessors
+    std::vector<int> levelOffsets;   // level k is order[levelOffsets[k], levelOffsets[k + 1])
+    std::vector<int> cycle;          // nodes of one directed cycle in arc order when the graph is not a DAG
+
+    bool isDag() const { return cycle.empty(); }
+    int getNumLevels() const { return static_cast<int>(levelOffsets.size()) - 1; }
+};
+
+// Nodes of a cycle among the nodes Kahn's algorithm could not remove. Each of
+// them still has a predecessor that was not removed either, so following one
+// such predecessor per node must run into a cycle.
+template <typename Weight>
+std::vector<int> findCycleInRemainingNodes(const BasicCsrGraph<Weight>& graph, const std::vector<int>& inDegrees) {
+    int numNodes = graph.getNumNodes();
+    std::vector<int> predecessors(numNodes, -1);
+
+    int anyRemaining = -1;
+    for (int from = 0; from < numNodes; from++) {
+        if (inDegrees[from] == 0) {
+            continue;
+        }
+        anyRemaining = from;
+
+        for (int arc = graph.getFirstArc(from); arc < graph.getLastArc(from); arc++) {
+            int to = graph.getTarget(arc);
+            if (inDegrees[to] > 0 && predecessors[to] == -1) {
+                predecessors[to] = from;
+            }
+        }
+    }
+
+    // walk backwards until a node repeats, that node is on the cycle
+    std::vector<bool> seen(numNodes, false);
+    int node = anyRemaining;
+    while (!seen[node]) {
+        seen[node] = true;
+        node = predecessors[node];
+    }
+
+    std::vector<int> cycle;
+    int current = node;
+    do {
+        cycle.push_back(current);
+        current = predecessors[current];
+    } while (current != node);
+
+    std::reverse(cycle.begin(), cycle.end());
+    return cycle;
+}
+
+// Kahn's algorithm over the CSR, iterative and O(V + E): nodes without
+// remaining in-arcs are appended to the order, and removing their out-arcs
+// releases the next ones. The order doubles as the queue and is processed
+// level by level - level 0 is every source node, level k + 1 the nodes
+// released by level k - so each level is an antichain whose nodes only
+// depend on earlier levels. Within a level the nodes are in ascending release
+// order, which makes the order deterministic.
+//
+// When the graph has a cycle the order stays incomplete and one cycle is
+// reported instead. Only the structure is read, so any weight type works.
+template <typename Weight>
+TopologicalOrder sortTopologically(const BasicCsrGraph<Weight>& graph) {
+    int numNodes = graph.getNumNodes();
+
+    std::vector<int> inDegrees(numNodes, 0);
+    for (int arc = 0; arc < graph.getNumArcs(); arc++) {
+        inDegrees[graph.getTarget(arc)]++;
+    }
+
+    TopologicalOrder result;
+    result.order.reserve(numNodes);
+
+    for (int node = 0; node < numNodes; node++) {
+        if (inDegrees[node] == 0) {
+            result.order.push_back(node);
+        }
+    }
+
+    std::size_t levelBegin = 0;
+    while (levelBegin < result.order.size()) {
+        std::size_t levelEnd = result.order.size();
+        result.levelOffsets.push_back(static_cast<int>(levelBegin));
+
+        for (std::size_t i = levelBegin; i < levelEnd; i++) {
+            int node = result.order[i];
+            for (int arc = graph.getFirstArc(node); arc < graph.getLastArc(node); arc++) {
+                int to = graph.getTarget(arc);
+                if (--inDegrees[to] == 0) {
+                    result.order.push_back(to);
+                }
+            }
+        }
+
+        levelBegin = levelEnd;
+    }
+    result.levelOffsets.push_back(static_cast<int>(result.order.size()));
+
+    if (static_cast<int>(result.order.size()) < numNodes) {
+        result.cycle = findCycleInRemainingNodes(graph, inDegrees);
+    }
+
+    return result;
+}
@@ -0,0 +1,92 @@
+// All-pairs shortest distances of a binary (.csrg) or plain text graph with
+// Johnson's algorithm (Common/Johnson.h), negative arc weights allowed. The
+// V x V matrix is either printed (one row per source, "-" for unreachable)
+// or streamed into a distance matrix file (.dmat) when an output is given,
+// which works for graphs whose matrix does not fit in memory.
+//
+// g++ -std=c++17 -O2 -pthread AllPairsDistances.cpp -o all_pairs_distances
+// ./all_pairs_distances <graph.csrg | graph.txt> [output.dmat] [--undirected] [--threads n]
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <limits>
+
+#include "../Common/CsrGraph.h"
+#include "../Common/BinaryGraphFormat.h"
+#include "../Common/DistanceTable.h"
+#include "../Common/Johnson.h"
+#include "../Common/Parallel.h"
+#include "../Common/Stopwatch.h"
+
+void printUsage() {
+    std::cerr << "Usage: all_pairs_distances <graph.csrg | graph.txt> [output.dmat] "
+              << "[--undirected] [--threads n]" << std::endl;
+}
+
+void printNegativeCycle(const std::vector<int>& cycle) {
+    std::cerr << "Negative cycle detected: ";
+    for (const int node : cycle) {
+        std::cerr << node << " -> ";
+    }
+    std::cerr << cycle.front() << std::endl;
+}
+
+void print(const DistanceMatrix& distances) {
+    for (int row = 0; row < distances.getNumRows(); row++) {
+        for (int column = 0; column < distances.getNumColumns(); column++) {
+            int distance = distances.get(row, column);
+            if (distance == std::numeric_limits<int>::max()) {
+                std::cout << "- ";
+            } else {
+                std::cout << distance << " ";
+            }
+        }
+        std::cout << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::string inputPath = argv[1], outputPath;
+    bool undirected = false;
+    int numThreads = getDefaultNumThreads();
+    for (int i = 2; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--undirected") {
+            undirected = true;
+        } else if (option == "--threads" && i + 1 < argc) {
+            numThreads = std::stoi(argv[++i]);
+        } else if (option.rfind("--", 0) != 0 && outputPath.empty()) {
+            outputPath = option;
+        } else {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    CsrGraph graph = loadGraph(inputPath, undirected);
+
+    Stopwatch stopwatch;
+    DistanceMatrix distances;
+    BellmanFordResult result = outputPath.empty() ? computeAllPairsDistances(graph, distances, numThreads)
+                                                  : saveAllPairsDistances(graph, outputPath, numThreads);
+    if (result.hasNegativeCycle) {
+        printNegativeCycle(result.negativeCycle);
+        return EXIT_FAILURE;
+    }
+    double elapsedMs = stopwatch.getElapsedMs();
+
+    if (outputPath.empty()) {
+        print(distances);
+    }
+
+    std::cerr << graph.getNumNodes() << " x " << graph.getNumNodes() << " distances in " << elapsedMs
+              << " ms on " << numThreads << " thread(s)" << std::endl;
+
+    return 0;
+}
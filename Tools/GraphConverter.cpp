@@ -0,0 +1,121 @@
+// Converts the text inputs of the programs into the binary graph format of
+// Common/BinaryGraphFormat.h.
+//
+// g++ -std=c++17 -O2 GraphConverter.cpp -o graph_converter
+// ./graph_converter <format> <input.txt | -> <output.csrg> [--undirected] [--reverse]
+//
+// formats:
+//   plain     "numNodes numEdges" then "src dest weight" lines
+//             (BellmanFordShortestPath, LongestPath, Undefined, BigTrip)
+//   dashed    "numNodes numEdges" then "from - to - weight" lines (CheapTawnTour)
+//   kruskal   "Nodes: n", "Edges: m" then "from to weight" lines (ModifiedKruskalAlgorithm)
+//   cable     "Budget: b", "Nodes: n", "Edges: m" then "from to weight [connected]" lines (CableNetwork)
+//   reliable  "Nodes: n", "Path: s - d", "Edges: m" then "from to weight" lines (MostReliablePath)
+//
+// Only the graph is converted - start nodes, budgets and "connected" marks stay
+// program arguments. dashed, kruskal, cable and reliable graphs are undirected
+// by default.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "../Common/CsrGraph.h"
+#include "../Common/FastInputReader.h"
+#include "../Common/BinaryGraphFormat.h"
+#include "../Common/Stopwatch.h"
+
+struct TextFormat {
+    std::string name;
+    int headerNumbersBeforeNodes;
+    int headerNumbersBetween;
+    bool undirected;
+};
+
+const std::vector<TextFormat> TEXT_FORMATS = {
+    { "plain",    0, 0, false },
+    { "dashed",   0, 0, true },
+    { "kruskal",  0, 0, true },
+    { "cable",    1, 0, true },
+    { "reliable", 0, 2, true },
+};
+
+void printUsage() {
+    std::cerr << "Usage: graph_converter <plain|dashed|kruskal|cable|reliable> <input.txt | -> <output.csrg> "
+              << "[--undirected] [--reverse]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    const TextFormat* format = nullptr;
+    for (const TextFormat& candidate : TEXT_FORMATS) {
+        if (candidate.name == argv[1]) {
+            format = &candidate;
+        }
+    }
+
+    if (format == nullptr) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::string inputPath = argv[2], outputPath = argv[3];
+    bool undirected = format->undirected, withReverse = false;
+    for (int i = 4; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--undirected") {
+            undirected = true;
+        } else if (option == "--reverse") {
+            withReverse = true;
+        } else {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    Stopwatch stopwatch;
+
+    std::unique_ptr<FastInputReader> reader = inputPath == "-" ?
+        std::make_unique<FastInputReader>(stdin) : std::make_unique<FastInputReader>(inputPath);
+
+    // budget of the cable format
+    for (int i = 0; i < format->headerNumbersBeforeNodes; i++) {
+        reader->readInt();
+    }
+
+    int numNodes = reader->readInt();
+
+    // start and end node of the reliable format
+    for (int i = 0; i < format->headerNumbersBetween; i++) {
+        reader->readInt();
+    }
+
+    int numEdges = reader->readInt();
+
+    std::vector<CsrEdge> edges;
+    edges.reserve(numEdges);
+
+    for (int i = 0; i < numEdges; i++) {
+        edges.push_back(reader->readEdge());
+        if (format->name == "cable") {
+            reader->skipLine();
+        }
+        numNodes = std::max(numNodes, std::max(edges.back().from, edges.back().to) + 1);
+    }
+
+    double parseMs = stopwatch.getElapsedMs();
+
+    CsrGraph graph(numNodes, edges, undirected, withReverse);
+    saveBinaryGraph(graph, outputPath);
+
+    std::cerr << "Converted " << numEdges << " edges (" << graph.getNumNodes() << " nodes, "
+              << graph.getNumArcs() << " arcs) - parsed in " << parseMs << " ms, total "
+              << stopwatch.getElapsedMs() << " ms" << std::endl;
+
+    return 0;
+}
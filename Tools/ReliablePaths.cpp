@@ -0,0 +1,124 @@
+// The k most reliable paths between two nodes of a network whose links work
+// with given probabilities (Common/ReliablePaths.h). The edge list is parsed
+// while it streams in and only the -log(p) costs are kept, so the input is
+// never held in memory as text or as probabilities.
+//
+// Input: "numNodes numEdges" followed by one "src dest probability" line per
+// edge, probabilities in [0, 1] (or in percent with --percent).
+//
+// g++ -std=c++17 -O2 ReliablePaths.cpp -o reliable_paths
+// ./reliable_paths <graph.txt | -> <start> <dest> [k] [--undirected] [--percent]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+
+#include "../Common/CsrGraph.h"
+#include "../Common/FastInputReader.h"
+#include "../Common/ReliablePaths.h"
+#include "../Common/Stopwatch.h"
+
+void printUsage() {
+    std::cerr << "Usage: reliable_paths <graph.txt | -> <start> <dest> [k] [--undirected] [--percent]" << std::endl;
+}
+
+// a directed graph also gets its reverse CSR, which the top-k search uses to aim at dest;
+// throws on a negative node id or a probability outside [0, 1]
+LogCostGraph readLogCostGraph(FastInputReader& reader, bool undirected, bool inPercent) {
+    int numNodes = reader.readInt();
+    int numEdges = reader.readInt();
+
+    std::vector<BasicCsrEdge<double>> edges;
+    edges.reserve(numEdges);
+    for (int i = 0; i < numEdges; i++) {
+        int from = reader.readInt();
+        int to = reader.readInt();
+        if (from < 0 || to < 0) {
+            throw std::runtime_error("Edge " + std::to_string(i + 1) + " has a negative node id");
+        }
+
+        double probability = reader.readDouble();
+        if (inPercent) {
+            probability /= 100.0;
+        }
+
+        edges.emplace_back(from, to, toLogCost(probability));
+        numNodes = std::max(numNodes, std::max(from, to) + 1);
+    }
+
+    return LogCostGraph(numNodes, edges, undirected, !undirected);
+}
+
+void print(int rank, const ReliablePath& path) {
+    std::cout << "#" << rank << "  reliability " << std::fixed << std::setprecision(4) << path.getPercentage()
+              << "%  log-likelihood " << std::setprecision(6) << path.logLikelihood << "  path: ";
+    for (std::size_t i = 0; i < path.nodes.size(); i++) {
+        std::cout << (i > 0 ? " -> " : "") << path.nodes[i];
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> arguments;
+    bool undirected = false, inPercent = false;
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument == "--undirected") {
+            undirected = true;
+        } else if (argument == "--percent") {
+            inPercent = true;
+        } else {
+            arguments.push_back(argument);
+        }
+    }
+
+    if (arguments.size() < 3 || arguments.size() > 4) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    int start = std::stoi(arguments[1]);
+    int dest = std::stoi(arguments[2]);
+    int k = arguments.size() > 3 ? std::stoi(arguments[3]) : 1;
+
+    Stopwatch stopwatch;
+    LogCostGraph graph;
+    try {
+        if (arguments[0] == "-") {
+            FastInputReader reader;
+            graph = readLogCostGraph(reader, undirected, inPercent);
+        } else {
+            FastInputReader reader(arguments[0]);
+            graph = readLogCostGraph(reader, undirected, inPercent);
+        }
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    double readMs = stopwatch.getElapsedMs();
+
+    if (start < 0 || start >= graph.getNumNodes() || dest < 0 || dest >= graph.getNumNodes()) {
+        std::cerr << "start and dest must be nodes of the graph" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    stopwatch.restart();
+    ReliablePathFinder<> finder(graph);
+    std::vector<ReliablePath> paths = finder.findMostReliablePaths(start, dest, k);
+    double searchMs = stopwatch.getElapsedMs();
+
+    if (paths.empty()) {
+        std::cout << dest << " can not be reached from " << start << std::endl;
+    }
+    for (std::size_t i = 0; i < paths.size(); i++) {
+        print(static_cast<int>(i) + 1, paths[i]);
+    }
+
+    std::cerr << graph.getNumNodes() << " nodes, " << graph.getNumArcs() << " arcs read in " << readMs
+              << " ms, " << paths.size() << " path(s) found in " << searchMs << " ms" << std::endl;
+
+    return 0;
+}